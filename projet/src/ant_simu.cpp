@@ -1,12 +1,17 @@
 #include <vector>
 #include <iostream>
+#include <memory>
 #include <random>
+#include <string>
+#include <cstdlib>
 #include "fractal_land.hpp"
 #include "ant.hpp"
 #include "pheronome.hpp"
 # include "renderer.hpp"
 # include "window.hpp"
 # include "rand_generator.hpp"
+# include "offscreen_renderer.hpp"
+# include "frame_writer.hpp"
 
 void advance_time( const fractal_land& land, pheronome& phen, 
                    const position_t& pos_nest, const position_t& pos_food,
@@ -14,13 +19,45 @@ void advance_time( const fractal_land& land, pheronome& phen,
 {
     for ( size_t i = 0; i < ants.size(); ++i )
         ants[i].advance(phen, land, pos_food, pos_nest, cpteur);
-    phen.do_evaporation();
     phen.update();
 }
 
+/*
+ * Usage : ./ant_simu.exe [--headless] [--iterations N] [--capture destination] [--capture-period K]
+ *   --headless       : pas de fenêtre ( nœud de calcul ), --iterations est alors obligatoire
+ *   --iterations N   : arrête la simulation après N itérations ( 0 : jusqu'à la fermeture de la fenêtre )
+ *   --capture dest   : enregistre une image toutes les K itérations ( voir FrameWriter pour dest )
+ */
 int main(int nargs, char* argv[])
 {
-    SDL_Init( SDL_INIT_VIDEO );
+    bool headless = false;
+    std::size_t nb_iterations = 0, capture_period = 1;
+    std::string capture;
+    for ( int iarg = 1; iarg < nargs; ++iarg ) {
+        std::string arg = argv[iarg];
+        if ( arg == "--headless" )
+            headless = true;
+        else if ( arg == "--iterations" && iarg + 1 < nargs )
+            nb_iterations = std::strtoul( argv[++iarg], nullptr, 10 );
+        else if ( arg == "--capture" && iarg + 1 < nargs )
+            capture = argv[++iarg];
+        else if ( arg == "--capture-period" && iarg + 1 < nargs )
+            capture_period = std::max( 1UL, std::strtoul( argv[++iarg], nullptr, 10 ) );
+        else
+            std::cerr << "Argument ignoré : " << arg << std::endl;
+    }
+    if ( headless && nb_iterations == 0 ) {
+        // Sans fenêtre, rien ne peut arrêter la boucle ( et --capture écrirait des images sans fin )
+        std::cerr << "Erreur : le mode sans fenêtre demande --iterations N ( N > 0 )" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if ( !capture.empty() && !FrameWriter::is_valid_destination( capture ) ) {
+        std::cerr << "Erreur : --capture attend \"|commande\" ou un motif de fichier avec un seul %d ( %05d, ... ) : "
+                  << capture << std::endl;
+        return EXIT_FAILURE;
+    }
+    if ( !headless )
+        SDL_Init( SDL_INIT_VIDEO );
     std::size_t seed = 2026; // Graine pour la génération aléatoire ( reproductible )
     const int nb_ants = 5000; // Nombre de fourmis
     const double eps = 0.8;  // Coefficient d'exploration
@@ -59,8 +96,19 @@ int main(int nargs, char* argv[])
     // On crée toutes les fourmis dans la fourmilière.
     pheronome phen(land.dimensions(), pos_food, pos_nest, alpha, beta);
 
-    Window win("Ant Simulation", 2*land.dimensions()+10, land.dimensions()+266);
-    Renderer renderer( land, phen, pos_nest, pos_food, ants );
+    std::unique_ptr<Window> win;
+    std::unique_ptr<Renderer> renderer;
+    if ( !headless ) {
+        win = std::make_unique<Window>("Ant Simulation", 2*land.dimensions()+10, land.dimensions()+266);
+        renderer = std::make_unique<Renderer>( land, phen, pos_nest, pos_food, ants );
+    }
+    // Capture d'images : rendu en mémoire, écriture par un thread séparé
+    std::unique_ptr<OffscreenRenderer> offscreen;
+    std::unique_ptr<FrameWriter> writer;
+    if ( !capture.empty() ) {
+        offscreen = std::make_unique<OffscreenRenderer>( land, phen, ants );
+        writer = std::make_unique<FrameWriter>( offscreen->width(), offscreen->height(), capture );
+    }
     // Compteur de la quantité de nourriture apportée au nid par les fourmis
     size_t food_quantity = 0;
     SDL_Event event;
@@ -69,19 +117,38 @@ int main(int nargs, char* argv[])
     std::size_t it = 0;
     while (cont_loop) {
         ++it;
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT)
-                cont_loop = false;
+        if ( !headless ) {
+            while (SDL_PollEvent(&event)) {
+                if (event.type == SDL_QUIT)
+                    cont_loop = false;
+            }
         }
         advance_time( land, phen, pos_nest, pos_food, ants, food_quantity );
-        renderer.display( win, food_quantity );
-        win.blit();
+        if ( !headless ) {
+            renderer->display( *win, food_quantity );
+            win->blit();
+        }
+        if ( writer && it % capture_period == 0 ) {
+            // Si le thread d'écriture est en retard, l'image est abandonnée plutôt que d'attendre
+            std::uint8_t* frame = writer->acquire();
+            if ( frame != nullptr ) {
+                offscreen->render( frame, food_quantity );
+                writer->submit( frame, it / capture_period );
+            }
+        }
+        if ( nb_iterations > 0 && it >= nb_iterations )
+            cont_loop = false;
         if ( not_food_in_nest && food_quantity > 0 ) {
             std::cout << "La première nourriture est arrivée au nid a l'iteration " << it << std::endl;
             not_food_in_nest = false;
         }
         //SDL_Delay(10);
     }
-    SDL_Quit();
+    if ( writer ) {
+        std::cout << "Images abandonnées ( écriture trop lente ) : " << writer->frames_dropped() << std::endl;
+        writer.reset(); // Attend l'écriture des images en attente
+    }
+    if ( !headless )
+        SDL_Quit();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include <mpi.h>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include "fractal_land.hpp"
+#include "ant.hpp"
+#include "pheronome.hpp"
+# include "renderer.hpp"
+# include "window.hpp"
+# include "rand_generator.hpp"
+# include "colony_snapshot.hpp"
+
+/*
+ * Version distribuée de la simulation ( "première façon" du sujet ) avec séparation calcul/affichage :
+ *   - le processus 0 ne fait que l'affichage : il possède la fenêtre et le Renderer, et reconstruit
+ *     une copie locale des phéronomes et des fourmis à partir des images reçues ;
+ *   - les processus 1..nbp-1 se partagent les fourmis, possèdent chacun toute la carte et fusionnent
+ *     leurs cartes de phéronomes ( maximum ) avant l'évaporation.
+ * Le processus 1 ( racine des processus de calcul ) envoie périodiquement une image réduite de la
+ * colonie au processus d'affichage avec un envoi non bloquant. Si l'image précédente n'est pas encore
+ * partie, la nouvelle est simplement abandonnée : les calculs n'attendent jamais l'affichage.
+ * Fermer la fenêtre détache le processus d'affichage, la simulation continue jusqu'au bout.
+ *
+ * Usage : mpirun -np <nbp> ./ant_simu_mpi.exe [nb_iterations] [facteur_reduction] [periode_affichage]
+ */
+
+namespace {
+const int viz_rank = 0;
+const int compute_root = 1;
+enum tags { tag_frame = 1, tag_detach = 2, tag_end = 3 };
+
+/* Protocole de détachement : le processus d'affichage envoie exactement un message tag_detach
+   ( à la fermeture de la fenêtre, ou en accusé de réception de tag_end ) et la racine de calcul
+   envoie exactement un message tag_end ( en réponse au détachement, ou en fin de simulation ). */
+
+void normalize_land( fractal_land& land )
+{
+    double max_val = 0.0;
+    double min_val = 0.0;
+    for ( fractal_land::dim_t i = 0; i < land.dimensions(); ++i )
+        for ( fractal_land::dim_t j = 0; j < land.dimensions(); ++j ) {
+            max_val = std::max(max_val, land(i,j));
+            min_val = std::min(min_val, land(i,j));
+        }
+    double delta = max_val - min_val;
+    for ( fractal_land::dim_t i = 0; i < land.dimensions(); ++i )
+        for ( fractal_land::dim_t j = 0; j < land.dimensions(); ++j )  {
+            land(i,j) = (land(i,j)-min_val)/delta;
+        }
+}
+// ====================================================================================================================
+void run_visualization( const fractal_land& land, const position_t& pos_nest, const position_t& pos_food,
+                        double alpha, double beta, MPI_Comm globComm )
+{
+    SDL_Init( SDL_INIT_VIDEO );
+    pheronome phen(land.dimensions(), pos_food, pos_nest, alpha, beta);
+    std::vector<ant> ants;
+    Window win("Ant Simulation (MPI)", 2*land.dimensions()+10, land.dimensions()+266);
+    Renderer renderer( land, phen, pos_nest, pos_food, ants );
+
+    std::vector<double> frame;
+    std::size_t iteration = 0, food_quantity = 0;
+    bool attached = true;   // On reçoit encore des images
+    bool cont_loop = true;  // La fenêtre est encore ouverte
+    SDL_Event event;
+    while ( cont_loop ) {
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT)
+                cont_loop = false;
+        }
+        if ( !attached ) {
+            SDL_Delay(10);
+            continue;
+        }
+        int flag = 0;
+        MPI_Status status;
+        MPI_Iprobe( compute_root, MPI_ANY_TAG, globComm, &flag, &status );
+        if ( !flag ) {
+            SDL_Delay(1);
+            continue;
+        }
+        if ( status.MPI_TAG == tag_end ) {
+            // Fin de la simulation : on accuse réception et on garde la dernière image à l'écran
+            MPI_Recv( nullptr, 0, MPI_BYTE, compute_root, tag_end, globComm, MPI_STATUS_IGNORE );
+            MPI_Send( nullptr, 0, MPI_BYTE, compute_root, tag_detach, globComm );
+            attached = false;
+            std::cout << "Simulation terminée a l'iteration " << iteration << std::endl;
+            continue;
+        }
+        int count = 0;
+        MPI_Get_count( &status, MPI_DOUBLE, &count );
+        frame.resize( count );
+        MPI_Recv( frame.data(), count, MPI_DOUBLE, compute_root, tag_frame, globComm, MPI_STATUS_IGNORE );
+        colony_snapshot::unpack( frame, land.dimensions(), phen, ants, iteration, food_quantity );
+        renderer.display( win, food_quantity );
+        win.blit();
+    }
+
+    if ( attached ) {
+        // Détachement en cours de simulation : on vide les images encore en vol jusqu'à tag_end
+        MPI_Send( nullptr, 0, MPI_BYTE, compute_root, tag_detach, globComm );
+        MPI_Status status;
+        do {
+            MPI_Probe( compute_root, MPI_ANY_TAG, globComm, &status );
+            int count = 0;
+            MPI_Get_count( &status, MPI_DOUBLE, &count );
+            frame.resize( count );
+            MPI_Recv( frame.data(), count, MPI_DOUBLE, compute_root, status.MPI_TAG, globComm, MPI_STATUS_IGNORE );
+        } while ( status.MPI_TAG != tag_end );
+        std::cout << "Affichage détaché a l'iteration " << iteration << std::endl;
+    }
+    SDL_Quit();
+}
+// ====================================================================================================================
+void run_computation( const fractal_land& land, const position_t& pos_nest, const position_t& pos_food,
+                      double alpha, double beta, int nb_ants, std::size_t seed,
+                      std::size_t nb_iterations, std::size_t ds, std::size_t period,
+                      MPI_Comm globComm, MPI_Comm computeComm )
+{
+    int nb_compute, compute_rank;
+    MPI_Comm_size( computeComm, &nb_compute );
+    MPI_Comm_rank( computeComm, &compute_rank );
+    bool is_root = ( compute_rank == 0 );
+
+    // Toutes les positions sont tirées par chaque processus ( même graine que la version séquentielle ),
+    // chacun ne garde que sa tranche de fourmis.
+    int ant_beg = ( nb_ants * compute_rank ) / nb_compute;
+    int ant_end = ( nb_ants * ( compute_rank + 1 ) ) / nb_compute;
+    std::vector<ant> ants;
+    ants.reserve( ant_end - ant_beg );
+    auto gen_ant_pos = [&land, &seed] () { return rand_int32(0, land.dimensions()-1, seed); };
+    for ( int i = 0; i < nb_ants; ++i ) {
+        position_t pos{gen_ant_pos(),gen_ant_pos()};
+        if ( i >= ant_beg && i < ant_end )
+            ants.emplace_back(pos, seed);
+    }
+    pheronome phen(land.dimensions(), pos_food, pos_nest, alpha, beta);
+
+    std::vector<int> counts, displs;
+    if ( is_root ) {
+        counts.resize( nb_compute );
+        displs.resize( nb_compute );
+        for ( int p = 0; p < nb_compute; ++p ) {
+            counts[p] = 2 * ( ( nb_ants * ( p + 1 ) ) / nb_compute - ( nb_ants * p ) / nb_compute );
+            displs[p] = 2 * ( ( nb_ants * p ) / nb_compute );
+        }
+    }
+    std::vector<int> local_positions( 2 * ants.size() ), all_positions( is_root ? 2 * nb_ants : 0 );
+    std::vector<double> frame;
+    MPI_Request frame_request = MPI_REQUEST_NULL;
+    int attached = 1;
+    std::size_t local_food = 0, food_quantity = 0, nb_sent = 0, nb_dropped = 0;
+    bool not_food_in_nest = true;
+
+    double t0 = MPI_Wtime();
+    for ( std::size_t it = 1; it <= nb_iterations; ++it ) {
+        for ( auto& a : ants )
+            a.advance(phen, land, pos_food, pos_nest, local_food);
+        if ( nb_compute > 1 ) {
+            phen.commit_marks();
+            MPI_Allreduce( MPI_IN_PLACE, phen.data()->data(), int( 2 * phen.size() ), MPI_DOUBLE,
+                           MPI_MAX, computeComm );
+        }
+        phen.update();
+
+        unsigned long long food_ull = local_food, total_food = 0;
+        MPI_Reduce( &food_ull, &total_food, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, computeComm );
+        food_quantity = total_food;
+        if ( is_root && not_food_in_nest && food_quantity > 0 ) {
+            std::cout << "La première nourriture est arrivée au nid a l'iteration " << it << std::endl;
+            not_food_in_nest = false;
+        }
+
+        if ( is_root && attached ) {
+            int flag = 0;
+            MPI_Iprobe( viz_rank, tag_detach, globComm, &flag, MPI_STATUS_IGNORE );
+            if ( flag ) {
+                MPI_Recv( nullptr, 0, MPI_BYTE, viz_rank, tag_detach, globComm, MPI_STATUS_IGNORE );
+                MPI_Wait( &frame_request, MPI_STATUS_IGNORE );
+                MPI_Send( nullptr, 0, MPI_BYTE, viz_rank, tag_end, globComm );
+                attached = 0;
+            }
+        }
+        if ( it % period != 0 ) continue;
+        MPI_Bcast( &attached, 1, MPI_INT, 0, computeComm );
+        if ( !attached ) continue;
+
+        for ( std::size_t a = 0; a < ants.size(); ++a ) {
+            local_positions[2 * a]     = ants[a].get_position().x;
+            local_positions[2 * a + 1] = ants[a].get_position().y;
+        }
+        MPI_Gatherv( local_positions.data(), int( local_positions.size() ), MPI_INT, all_positions.data(),
+                     counts.data(), displs.data(), MPI_INT, 0, computeComm );
+        if ( is_root ) {
+            int done = 0;
+            MPI_Test( &frame_request, &done, MPI_STATUS_IGNORE );
+            if ( done ) {
+                colony_snapshot::pack( frame, it, food_quantity, phen, land.dimensions(), ds, all_positions );
+                MPI_Isend( frame.data(), int( frame.size() ), MPI_DOUBLE, viz_rank, tag_frame, globComm,
+                           &frame_request );
+                ++nb_sent;
+            } else
+                ++nb_dropped;
+        }
+    }
+    double t1 = MPI_Wtime();
+
+    if ( is_root ) {
+        if ( attached ) {
+            MPI_Wait( &frame_request, MPI_STATUS_IGNORE );
+            MPI_Send( nullptr, 0, MPI_BYTE, viz_rank, tag_end, globComm );
+            MPI_Recv( nullptr, 0, MPI_BYTE, viz_rank, tag_detach, globComm, MPI_STATUS_IGNORE );
+        }
+        std::cout << "Nourriture rapportée : " << food_quantity << " en " << nb_iterations << " iterations ("
+                  << t1 - t0 << " s)" << std::endl;
+        std::cout << "Images envoyées : " << nb_sent << ", abandonnées : " << nb_dropped << std::endl;
+    }
+}
+}  // namespace
+
+int main(int nargs, char* argv[])
+{
+    MPI_Init( &nargs, &argv );
+    MPI_Comm globComm;
+    MPI_Comm_dup( MPI_COMM_WORLD, &globComm );
+    int nbp, rank;
+    MPI_Comm_size( globComm, &nbp );
+    MPI_Comm_rank( globComm, &rank );
+    if ( nbp < 2 ) {
+        if ( rank == 0 ) std::cerr << "Il faut au moins deux processus ( un d'affichage et un de calcul )" << std::endl;
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+
+    std::size_t nb_iterations = ( nargs > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000 );
+    std::size_t ds            = ( nargs > 2 ? std::strtoul(argv[2], nullptr, 10) : 1 );
+    std::size_t period        = ( nargs > 3 ? std::strtoul(argv[3], nullptr, 10) : 1 );
+    if ( ds == 0 ) ds = 1;
+    if ( period == 0 ) period = 1;
+
+    std::size_t seed = 2026; // Graine pour la génération aléatoire ( reproductible )
+    const int nb_ants = 5000; // Nombre de fourmis
+    const double eps = 0.8;  // Coefficient d'exploration
+    const double alpha=0.7; // Coefficient de chaos
+    const double beta=0.999; // Coefficient d'évaporation
+    position_t pos_nest{256,256};
+    position_t pos_food{500,500};
+    // Chaque processus génère le même territoire ( même graine ), rien à communiquer
+    fractal_land land(8,2,1.,1024);
+    normalize_land( land );
+    ant::set_exploration_coef(eps);
+
+    MPI_Comm computeComm;
+    MPI_Comm_split( globComm, rank == viz_rank ? MPI_UNDEFINED : 0, rank, &computeComm );
+    if ( rank == viz_rank )
+        run_visualization( land, pos_nest, pos_food, alpha, beta, globComm );
+    else {
+        run_computation( land, pos_nest, pos_food, alpha, beta, nb_ants, seed, nb_iterations, ds, period,
+                         globComm, computeComm );
+        MPI_Comm_free( &computeComm );
+    }
+
+    MPI_Comm_free( &globComm );
+    MPI_Finalize();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "fractal_land.hpp"
+#include "ant.hpp"
+#include "pheronome.hpp"
+# include "renderer.hpp"
+# include "window.hpp"
+# include "rand_generator.hpp"
+
+/*
+ * Mesure isolée des noyaux de la simulation ( construction du paysage, dépôt des phéronomes, mise à jour
+ * de la carte avec évaporation, déplacement des fourmis, affichage ) pour plusieurs tailles de carte et
+ * nombres de fourmis. Chaque mesure est répétée après quelques exécutions de chauffe ; on garde la médiane
+ * et les centiles 10/90.
+ *
+ * Usage : ./bench_kernels.exe [--sizes 513,1025,...] [--ants 1000,5000,...] [--reps R] [--warmup W]
+ *                             [--out resultats.json] [--baseline reference.json] [--tolerance 0.10]
+ *                             [--no-display]
+ * Avec --baseline, chaque mesure est comparée à la médiane de référence de même nom/taille/fourmis :
+ * le programme renvoie un code d'erreur si l'une d'elles est plus lente de plus de tolerance ( 10% par défaut ).
+ */
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+struct BenchResult {
+    std::string name;
+    std::size_t size, nb_ants;
+    double median, p10, p90, min;
+    double work;        // Nombre d'unités traitées par exécution
+    std::string unit;   // Unité du débit ( work / médiane )
+};
+
+double percentile( std::vector<double> sorted, double p )
+{
+    double pos = p * double( sorted.size() - 1 );
+    std::size_t i = std::size_t( pos );
+    if ( i + 1 >= sorted.size() ) return sorted.back();
+    return sorted[i] + ( pos - double( i ) ) * ( sorted[i + 1] - sorted[i] );
+}
+
+/// Exécute setup puis kernel warmup+reps fois et ne chronomètre que kernel
+BenchResult run( const std::string& name, std::size_t size, std::size_t nb_ants, double work,
+                 const std::string& unit, int warmup, int reps,
+                 const std::function<void()>& setup, const std::function<void()>& kernel )
+{
+    std::vector<double> times;
+    for ( int r = 0; r < warmup + reps; ++r ) {
+        setup();
+        auto t0 = clock_type::now();
+        kernel();
+        auto t1 = clock_type::now();
+        if ( r >= warmup )
+            times.push_back( std::chrono::duration<double>( t1 - t0 ).count() );
+    }
+    std::sort( times.begin(), times.end() );
+    BenchResult res{name, size, nb_ants, percentile( times, 0.5 ), percentile( times, 0.1 ),
+                    percentile( times, 0.9 ), times.front(), work, unit};
+    std::cout << std::left << std::setw(18) << name << " dim=" << std::setw(6) << size
+              << " ants=" << std::setw(7) << nb_ants << std::right
+              << " median=" << std::scientific << std::setprecision(3) << res.median << "s"
+              << " p10=" << res.p10 << "s p90=" << res.p90 << "s  "
+              << work / res.median << " " << unit << std::defaultfloat << std::endl;
+    return res;
+}
+
+std::vector<std::size_t> parse_list( const std::string& arg )
+{
+    std::vector<std::size_t> values;
+    std::stringstream sstr( arg );
+    std::string item;
+    while ( std::getline( sstr, item, ',' ) )
+        if ( !item.empty() ) values.push_back( std::strtoul( item.c_str(), nullptr, 10 ) );
+    return values;
+}
+
+/// Taille de carte nbSeeds*2^log_size+1 avec nbSeeds=2 : renvoie log_size, ou 0 si dim n'est pas de cette forme
+unsigned long log_size_of( std::size_t dim )
+{
+    for ( unsigned long l = 1; l < 20; ++l )
+        if ( 2UL * ( 1UL << l ) + 1 == dim ) return l;
+    return 0;
+}
+
+void normalize_land( fractal_land& land )
+{
+    double max_val = 0.0, min_val = 0.0;
+    for ( fractal_land::dim_t i = 0; i < land.dimensions(); ++i )
+        for ( fractal_land::dim_t j = 0; j < land.dimensions(); ++j ) {
+            max_val = std::max(max_val, land(i,j));
+            min_val = std::min(min_val, land(i,j));
+        }
+    double delta = max_val - min_val;
+    for ( fractal_land::dim_t i = 0; i < land.dimensions(); ++i )
+        for ( fractal_land::dim_t j = 0; j < land.dimensions(); ++j )
+            land(i,j) = (land(i,j)-min_val)/delta;
+}
+
+void write_json( const std::string& file_name, const std::vector<BenchResult>& results )
+{
+    std::ofstream out( file_name );
+    out << "{\n  \"benchmarks\": [\n" << std::setprecision(9);
+    for ( std::size_t i = 0; i < results.size(); ++i ) {
+        const BenchResult& r = results[i];
+        // Un enregistrement par ligne : c'est ce que relit read_baseline
+        out << "    {\"name\": \"" << r.name << "\", \"size\": " << r.size << ", \"ants\": " << r.nb_ants
+            << ", \"median_s\": " << r.median << ", \"p10_s\": " << r.p10 << ", \"p90_s\": " << r.p90
+            << ", \"min_s\": " << r.min << ", \"throughput\": " << r.work / r.median
+            << ", \"unit\": \"" << r.unit << "\"}" << ( i + 1 < results.size() ? "," : "" ) << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+std::string json_field( const std::string& line, const std::string& key )
+{
+    std::string pattern = "\"" + key + "\": ";
+    std::size_t pos = line.find( pattern );
+    if ( pos == std::string::npos ) return "";
+    pos += pattern.size();
+    if ( line[pos] == '"' ) return line.substr( pos + 1, line.find( '"', pos + 1 ) - pos - 1 );
+    return line.substr( pos, line.find_first_of( ",}", pos ) - pos );
+}
+
+using bench_key = std::tuple<std::string, std::size_t, std::size_t>;
+
+std::map<bench_key, double> read_baseline( const std::string& file_name )
+{
+    std::map<bench_key, double> baseline;
+    std::ifstream in( file_name );
+    if ( !in ) {
+        std::cerr << "Impossible de lire la référence " << file_name << std::endl;
+        return baseline;
+    }
+    std::string line;
+    while ( std::getline( in, line ) ) {
+        std::string name = json_field( line, "name" );
+        if ( name.empty() ) continue;
+        baseline[bench_key{name, std::strtoul( json_field( line, "size" ).c_str(), nullptr, 10 ),
+                           std::strtoul( json_field( line, "ants" ).c_str(), nullptr, 10 )}] =
+            std::strtod( json_field( line, "median_s" ).c_str(), nullptr );
+    }
+    return baseline;
+}
+}  // namespace
+
+int main(int nargs, char* argv[])
+{
+    std::vector<std::size_t> sizes{513, 1025, 2049, 4097, 8193};
+    std::vector<std::size_t> ant_counts{1000, 5000, 20000};
+    int reps = 10, warmup = 2;
+    double tolerance = 0.10;
+    bool with_display = true;
+    std::string out_file = "bench_kernels.json", baseline_file;
+    for ( int iarg = 1; iarg < nargs; ++iarg ) {
+        std::string arg = argv[iarg];
+        bool has_value = iarg + 1 < nargs;
+        if ( arg == "--sizes" && has_value ) sizes = parse_list( argv[++iarg] );
+        else if ( arg == "--ants" && has_value ) ant_counts = parse_list( argv[++iarg] );
+        else if ( arg == "--reps" && has_value ) reps = std::max( 1, std::atoi( argv[++iarg] ) );
+        else if ( arg == "--warmup" && has_value ) warmup = std::max( 0, std::atoi( argv[++iarg] ) );
+        else if ( arg == "--out" && has_value ) out_file = argv[++iarg];
+        else if ( arg == "--baseline" && has_value ) baseline_file = argv[++iarg];
+        else if ( arg == "--tolerance" && has_value ) tolerance = std::strtod( argv[++iarg], nullptr );
+        else if ( arg == "--no-display" ) with_display = false;
+        else std::cerr << "Argument ignoré : " << arg << std::endl;
+    }
+    if ( with_display && SDL_Init( SDL_INIT_VIDEO ) != 0 ) {
+        std::cerr << "Pas d'affichage disponible, Renderer::display n'est pas mesuré" << std::endl;
+        with_display = false;
+    }
+
+    std::vector<BenchResult> results;
+    const double alpha = 0.7, beta = 0.999;
+    ant::set_exploration_coef( 0.8 );
+    for ( std::size_t dim : sizes ) {
+        unsigned long log_size = log_size_of( dim );
+        if ( log_size == 0 ) {
+            std::cerr << "Taille " << dim << " ignorée : doit valoir 2*2^k+1 ( 513, 1025, ... )" << std::endl;
+            continue;
+        }
+        double nb_cells = double( dim ) * double( dim );
+
+        // Construction du paysage : on ne garde pas le paysage construit dans la boucle
+        results.push_back( run( "fractal_land", dim, 0, nb_cells, "cells/s", std::min( warmup, 1 ), reps,
+                                [] {}, [log_size] { fractal_land land( log_size, 2, 1., 1024 ); } ) );
+
+        fractal_land land( log_size, 2, 1., 1024 );
+        normalize_land( land );
+        position_t pos_nest{int( dim / 2 ), int( dim / 2 )};
+        position_t pos_food{int( dim - 13 ), int( dim - 13 )};
+        pheronome phen( dim, pos_food, pos_nest, alpha, beta );
+
+        // Dépôt de phéronomes sur des cellules tirées au hasard ( tirées hors chronométrage )
+        const std::size_t nb_marks = 1UL << 20;
+        std::vector<position_t> marks( nb_marks );
+        std::size_t seed = 2026;
+        for ( auto& pos : marks )
+            pos = position_t{rand_int32( 0, int( dim ) - 1, seed ), rand_int32( 0, int( dim ) - 1, seed )};
+        results.push_back( run( "mark_pheronome", dim, 0, double( nb_marks ), "marks/s", warmup, reps,
+                                [&] { phen.commit_marks(); },
+                                [&] { for ( const auto& pos : marks ) phen.mark_pheronome( pos ); } ) );
+
+        results.push_back( run( "update", dim, 0, nb_cells, "cells/s", warmup, reps, [] {},
+                                [&] { phen.update(); } ) );
+
+        for ( std::size_t nb_ants : ant_counts ) {
+            std::vector<ant> ants, initial_ants;
+            std::size_t ant_seed = 2026;
+            for ( std::size_t a = 0; a < nb_ants; ++a )
+                initial_ants.emplace_back( position_t{rand_int32( 0, int( dim ) - 1, ant_seed ),
+                                                      rand_int32( 0, int( dim ) - 1, ant_seed )}, ant_seed );
+            std::size_t food = 0;
+            // Un pas de temps de toutes les fourmis depuis la même configuration initiale ; chaque fourmi fait
+            // plusieurs déplacements par pas, le débit compte donc des fourmis avancées, pas des déplacements
+            results.push_back( run( "ant_advance", dim, nb_ants, double( nb_ants ), "ants/s", warmup, reps,
+                                    [&] { std::vector<ant>( initial_ants ).swap( ants ); },
+                                    [&] { for ( auto& a : ants ) a.advance( phen, land, pos_food, pos_nest, food ); } ) );
+
+            if ( with_display ) {
+                Window win( "Benchmark", 2 * int( dim ) + 10, int( dim ) + 266 );
+                Renderer renderer( land, phen, pos_nest, pos_food, initial_ants );
+                std::size_t compteur = 0;
+                renderer.display( win, compteur ); // Construction de la texture du paysage hors mesure
+                results.push_back( run( "renderer_display", dim, nb_ants, nb_cells, "cells/s", warmup, reps, [] {},
+                                        [&] { renderer.display( win, compteur ); } ) );
+            }
+        }
+    }
+    if ( with_display )
+        SDL_Quit();
+
+    write_json( out_file, results );
+    std::cout << "Résultats écrits dans " << out_file << std::endl;
+
+    if ( baseline_file.empty() ) return EXIT_SUCCESS;
+    auto baseline = read_baseline( baseline_file );
+    int nb_regressions = 0;
+    for ( const BenchResult& r : results ) {
+        auto it = baseline.find( bench_key{r.name, r.size, r.nb_ants} );
+        if ( it == baseline.end() || it->second <= 0. ) continue;
+        double ratio = r.median / it->second;
+        bool regression = ratio > 1. + tolerance;
+        nb_regressions += regression ? 1 : 0;
+        std::cout << ( regression ? "REGRESSION " : "ok         " ) << std::left << std::setw(18) << r.name
+                  << " dim=" << std::setw(6) << r.size << " ants=" << std::setw(7) << r.nb_ants << std::right
+                  << " x" << std::fixed << std::setprecision(3) << ratio << std::defaultfloat << std::endl;
+    }
+    std::cout << nb_regressions << " régression(s) au-delà de " << 100. * tolerance << "%" << std::endl;
+    return nb_regressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
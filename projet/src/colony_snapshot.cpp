@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <cassert>
+#include "colony_snapshot.hpp"
+
+void colony_snapshot::pack( std::vector<double>& buffer, std::size_t iteration, std::size_t food,
+                            const pheronome& phen, std::size_t dim, std::size_t ds,
+                            const std::vector<int>& positions )
+{
+    assert( ds > 0 );
+    std::size_t sub_dim = reduced_dimension( dim, ds );
+    std::size_t nb_ants = positions.size( ) / 2;
+    buffer.resize( header_size + 2 * sub_dim * sub_dim + positions.size( ) );
+    buffer[0] = double( iteration );
+    buffer[1] = double( food );
+    buffer[2] = double( ds );
+    buffer[3] = double( sub_dim );
+    buffer[4] = double( nb_ants );
+
+    double* plane = buffer.data( ) + header_size;
+    std::fill( plane, plane + 2 * sub_dim * sub_dim, 0. );
+    for ( std::size_t i = 0; i < dim; ++i )
+        for ( std::size_t j = 0; j < dim; ++j ) {
+            const pheronome::pheronome_t& cell = phen( i, j );
+            double* red_cell = plane + 2 * ( ( i / ds ) * sub_dim + j / ds );
+            red_cell[0] = std::max( red_cell[0], cell[0] );
+            red_cell[1] = std::max( red_cell[1], cell[1] );
+        }
+
+    std::copy( positions.begin( ), positions.end( ), plane + 2 * sub_dim * sub_dim );
+}
+// ====================================================================================================================
+void colony_snapshot::unpack( const std::vector<double>& buffer, std::size_t dim, pheronome& phen,
+                              std::vector<ant>& ants, std::size_t& iteration, std::size_t& food )
+{
+    assert( buffer.size( ) >= header_size );
+    iteration           = std::size_t( buffer[0] );
+    food                = std::size_t( buffer[1] );
+    std::size_t ds      = std::size_t( buffer[2] );
+    std::size_t sub_dim = std::size_t( buffer[3] );
+    std::size_t nb_ants = std::size_t( buffer[4] );
+    assert( buffer.size( ) == header_size + 2 * sub_dim * sub_dim + 2 * nb_ants );
+
+    const double* plane = buffer.data( ) + header_size;
+    for ( std::size_t i = 0; i < dim; ++i )
+        for ( std::size_t j = 0; j < dim; ++j ) {
+            const double* red_cell = plane + 2 * ( ( i / ds ) * sub_dim + j / ds );
+            phen( i, j ) = {{red_cell[0], red_cell[1]}};
+        }
+
+    const double* pos = plane + 2 * sub_dim * sub_dim;
+    ants.clear( );
+    ants.reserve( nb_ants );
+    for ( std::size_t a = 0; a < nb_ants; ++a )
+        ants.emplace_back( position_t{int( pos[2 * a] ), int( pos[2 * a + 1] )}, 0 );
+}
+// ====================================================================================================================
@@ -0,0 +1,49 @@
+#ifndef _COLONY_SNAPSHOT_HPP_
+#define _COLONY_SNAPSHOT_HPP_
+#include <cstddef>
+#include <vector>
+#include "ant.hpp"
+#include "pheronome.hpp"
+#include "basic_types.hpp"
+
+/**
+ * @brief Image ( éventuellement sous-échantillonnée ) de l'état de la colonie
+ * @details Sert à transmettre l'état de la simulation des processus de calcul vers le processus
+ *          d'affichage. L'image est sérialisée dans un unique tampon de double :
+ *
+ *          [ itération, nourriture, facteur ds, dimension réduite, nombre de fourmis,
+ *            phéronomes réduits ( 2 valeurs par cellule réduite ),
+ *            positions des fourmis ( x, y pour chaque fourmi ) ]
+ *
+ *          Une cellule réduite correspond à un bloc de ds x ds cellules de la carte dont on garde
+ *          le maximum de chaque phéronome, ce qui préserve les pistes fines à l'affichage.
+ */
+class colony_snapshot
+{
+public:
+    static constexpr std::size_t header_size = 5;
+
+    /**
+     * @brief Sérialise l'état de la colonie dans buffer
+     *
+     * @param dim Nombre de cellules de la carte dans chaque direction
+     * @param ds Facteur de sous-échantillonnage ( 1 : carte complète )
+     * @param positions Positions des fourmis, rangées par couple ( x, y )
+     */
+    static void pack( std::vector<double>& buffer, std::size_t iteration, std::size_t food,
+                      const pheronome& phen, std::size_t dim, std::size_t ds,
+                      const std::vector<int>& positions );
+
+    /**
+     * @brief Reconstruit l'état de la colonie à partir d'un tampon reçu
+     * @details Chaque cellule réduite est recopiée sur le bloc ds x ds correspondant de phen,
+     *          et les fourmis sont recréées aux positions reçues.
+     */
+    static void unpack( const std::vector<double>& buffer, std::size_t dim, pheronome& phen,
+                        std::vector<ant>& ants, std::size_t& iteration, std::size_t& food );
+
+    /// Dimension de la carte réduite pour une carte de dim cellules et un facteur ds
+    static std::size_t reduced_dimension( std::size_t dim, std::size_t ds ) { return ( dim + ds - 1 ) / ds; }
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "frame_writer.hpp"
+
+FrameWriter::FrameWriter( int width, int height, const std::string& destination, std::size_t nb_buffers )
+    :   m_width( width ),
+        m_height( height ),
+        m_destination( destination ),
+        m_pool( std::max<std::size_t>( nb_buffers, 1 ), std::vector<std::uint8_t>( 3UL * width * height ) )
+{
+    if ( !m_destination.empty() && m_destination[0] == '|' ) {
+        m_pipe = popen( m_destination.c_str() + 1, "w" );
+        if ( m_pipe == nullptr )
+            std::cerr << "Impossible de lancer l'encodeur : " << m_destination.substr( 1 ) << std::endl;
+    }
+    else {
+        m_raw = ( m_destination.size() >= 4 && m_destination.compare( m_destination.size() - 4, 4, ".raw" ) == 0 );
+        if ( !parse_pattern( m_destination, m_prefix, m_suffix, m_digits, m_zero_pad ) ) {
+            std::cerr << "Motif de capture invalide ( un seul %d attendu ) : " << m_destination << std::endl;
+            m_destination.clear();
+        }
+    }
+    for ( auto& buffer : m_pool )
+        m_free.push_back( buffer.data() );
+    m_thread = std::thread( &FrameWriter::write_loop, this );
+}
+// ====================================================================================================================
+bool FrameWriter::is_valid_destination( const std::string& destination )
+{
+    if ( !destination.empty() && destination[0] == '|' ) return destination.size() > 1;
+    std::string prefix, suffix;
+    int digits;
+    bool zero_pad;
+    return parse_pattern( destination, prefix, suffix, digits, zero_pad );
+}
+// ====================================================================================================================
+bool FrameWriter::parse_pattern( const std::string& pattern, std::string& prefix, std::string& suffix,
+                                 int& digits, bool& zero_pad )
+{
+    prefix.clear();
+    suffix.clear();
+    digits = 0;
+    zero_pad = false;
+    bool found = false;
+    for ( std::size_t i = 0; i < pattern.size(); ++i ) {
+        std::string& out = found ? suffix : prefix;
+        if ( pattern[i] != '%' ) {
+            out += pattern[i];
+            continue;
+        }
+        if ( ++i < pattern.size() && pattern[i] == '%' ) {
+            out += '%';
+            continue;
+        }
+        if ( found ) return false; // seconde directive
+        if ( i < pattern.size() && pattern[i] == '0' ) {
+            zero_pad = true;
+            ++i;
+        }
+        for ( ; i < pattern.size() && pattern[i] >= '0' && pattern[i] <= '9'; ++i ) {
+            digits = 10 * digits + ( pattern[i] - '0' );
+            if ( digits > 20 ) return false;
+        }
+        if ( i >= pattern.size() || pattern[i] != 'd' ) return false;
+        found = true;
+    }
+    return found;
+}
+// ====================================================================================================================
+FrameWriter::~FrameWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_stop = true;
+    }
+    m_cond.notify_one();
+    m_thread.join();
+    if ( m_pipe != nullptr )
+        pclose( m_pipe );
+}
+// ====================================================================================================================
+std::uint8_t* FrameWriter::acquire()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    if ( m_free.empty() ) {
+        ++m_dropped;
+        return nullptr;
+    }
+    std::uint8_t* frame = m_free.front();
+    m_free.pop_front();
+    return frame;
+}
+// ====================================================================================================================
+void FrameWriter::submit( std::uint8_t* frame, std::size_t index )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_ready.emplace_back( frame, index );
+    }
+    m_cond.notify_one();
+}
+// ====================================================================================================================
+std::size_t FrameWriter::frames_written() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    return m_written;
+}
+// ====================================================================================================================
+std::size_t FrameWriter::frames_dropped() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    return m_dropped;
+}
+// ====================================================================================================================
+void FrameWriter::write_loop()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    while ( true ) {
+        m_cond.wait( lock, [this] { return m_stop || !m_ready.empty(); } );
+        if ( m_ready.empty() ) break; // m_stop et plus rien à écrire
+        auto job = m_ready.front();
+        m_ready.pop_front();
+        // Les entrées/sorties se font sans tenir le verrou
+        lock.unlock();
+        write_frame( job.first, job.second );
+        lock.lock();
+        m_free.push_back( job.first );
+        ++m_written;
+    }
+}
+// ====================================================================================================================
+void FrameWriter::write_frame( const std::uint8_t* frame, std::size_t index )
+{
+    std::size_t nb_bytes = 3UL * m_width * m_height;
+    if ( m_pipe != nullptr ) {
+        std::fprintf( m_pipe, "P6\n%d %d\n255\n", m_width, m_height );
+        std::fwrite( frame, 1, nb_bytes, m_pipe );
+        return;
+    }
+    if ( m_destination.empty() || m_destination[0] == '|' ) return;
+
+    // Seul le numéro passe par snprintf, avec un format fixe : le motif lui-même n'est jamais interprété
+    char number[32];
+    std::snprintf( number, sizeof( number ), m_zero_pad ? "%0*d" : "%*d", m_digits, static_cast<int>( index ) );
+    const std::string file_name = m_prefix + number + m_suffix;
+    std::FILE* file = std::fopen( file_name.c_str(), "wb" );
+    if ( file == nullptr ) {
+        std::cerr << "Impossible d'écrire l'image " << file_name << std::endl;
+        return;
+    }
+    if ( !m_raw )
+        std::fprintf( file, "P6\n%d %d\n255\n", m_width, m_height );
+    std::fwrite( frame, 1, nb_bytes, file );
+    std::fclose( file );
+}
+// ====================================================================================================================
@@ -0,0 +1,68 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Écriture asynchrone d'images RGB sur disque ou vers un encodeur
+ * @details Les images sont écrites par un thread dédié. Le thread de simulation emprunte un tampon libre
+ *          avec acquire(), dessine dedans puis le rend avec submit(). Le nombre de tampons est borné :
+ *          si le thread d'écriture est en retard, acquire() renvoie nullptr et l'image est abandonnée,
+ *          la simulation n'attend donc jamais les entrées/sorties.
+ *
+ *          La destination est donnée par une chaîne :
+ *            - "|commande" : les images sont envoyées au format PPM sur l'entrée standard de la commande
+ *              ( par exemple "|ffmpeg -y -f image2pipe -vcodec ppm -i - -pix_fmt yuv420p traces.mp4" ) ;
+ *            - un motif de nom de fichier se terminant par ".raw" ( "frames/f%05d.raw" ) : une image RGB brute par fichier ;
+ *            - tout autre motif de nom de fichier ( "frames/f%05d.ppm" ) : une image PPM par fichier.
+ *          Un motif contient exactement un numéro d'image %d, éventuellement avec une largeur ( %5d, %05d ), et
+ *          aucune autre directive que %% ( un % littéral ). Il n'est jamais passé à printf : seul le numéro est
+ *          formaté. Vérifier le motif avec is_valid_destination avant de construire le FrameWriter.
+ */
+class FrameWriter
+{
+public:
+    FrameWriter( int width, int height, const std::string& destination, std::size_t nb_buffers = 4 );
+    /// Vrai si destination est une commande ( "|..." ) ou un motif de nom de fichier valide ( cf. ci-dessus )
+    static bool is_valid_destination( const std::string& destination );
+    FrameWriter( const FrameWriter& ) = delete;
+    FrameWriter& operator = ( const FrameWriter& ) = delete;
+    /// Écrit les images encore en attente puis arrête le thread d'écriture
+    ~FrameWriter();
+
+    /// Renvoie un tampon libre de 3*width*height octets, ou nullptr s'il n'y en a pas ( image abandonnée )
+    std::uint8_t* acquire();
+    /// Confie le tampon rempli au thread d'écriture
+    void submit( std::uint8_t* frame, std::size_t index );
+
+    std::size_t frames_written() const;
+    std::size_t frames_dropped() const;
+private:
+    void write_loop();
+    void write_frame( const std::uint8_t* frame, std::size_t index );
+    /// Découpe le motif en préfixe, numéro ( largeur, complété par des zéros ou non ) et suffixe
+    static bool parse_pattern( const std::string& pattern, std::string& prefix, std::string& suffix,
+                               int& digits, bool& zero_pad );
+
+    int m_width, m_height;
+    std::string m_destination;
+    std::FILE* m_pipe{ nullptr };
+    bool m_raw{ false };
+    std::string m_prefix, m_suffix;
+    int m_digits{ 0 };
+    bool m_zero_pad{ false };
+    std::vector<std::vector<std::uint8_t>> m_pool;
+    std::deque<std::uint8_t*> m_free;
+    std::deque<std::pair<std::uint8_t*, std::size_t>> m_ready;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_stop{ false };
+    std::size_t m_written{ 0 }, m_dropped{ 0 };
+    std::thread m_thread;
+};
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include "offscreen_renderer.hpp"
+
+OffscreenRenderer::OffscreenRenderer( const fractal_land& land, const pheronome& phen,
+                                      const std::vector<ant>& ants )
+    :   m_ref_land( land ),
+        m_ref_phen( phen ),
+        m_ref_ants( ants ),
+        m_dim( static_cast<int>( land.dimensions() ) ),
+        m_width( 2 * m_dim + 10 ),
+        m_height( m_dim + 266 ),
+        m_land( std::size_t( m_dim ) * m_dim )
+{
+    double min_height{std::numeric_limits<double>::max()}, max_height{std::numeric_limits<double>::lowest()};
+    for ( fractal_land::dim_t i = 0; i < m_ref_land.dimensions( ); ++i )
+        for ( fractal_land::dim_t j = 0; j < m_ref_land.dimensions( ); ++j ) {
+            min_height = std::min( min_height, m_ref_land( i, j ) );
+            max_height = std::max( max_height, m_ref_land( i, j ) );
+        }
+    // Image stockée ligne par ligne ( j ) comme dans la texture de Renderer
+    for ( fractal_land::dim_t i = 0; i < m_ref_land.dimensions( ); ++i )
+        for ( fractal_land::dim_t j = 0; j < m_ref_land.dimensions( ); ++j ) {
+            double c = 255. * ( m_ref_land( i, j ) - min_height ) / ( max_height - min_height );
+            m_land[j * m_dim + i] = static_cast<std::uint8_t>( c );
+        }
+}
+// ====================================================================================================================
+void OffscreenRenderer::pset( std::uint8_t* rgb, int x, int y,
+                              std::uint8_t r, std::uint8_t g, std::uint8_t b ) const
+{
+    if ( x < 0 || y < 0 || x >= m_width || y >= m_height ) return;
+    std::uint8_t* pixel = rgb + 3 * ( std::size_t( y ) * m_width + x );
+    pixel[0] = r; pixel[1] = g; pixel[2] = b;
+}
+// ====================================================================================================================
+void OffscreenRenderer::line( std::uint8_t* rgb, int x1, int y1, int x2, int y2,
+                              std::uint8_t r, std::uint8_t g, std::uint8_t b ) const
+{
+    // Algorithme de Bresenham
+    int dx = std::abs( x2 - x1 ), sx = ( x1 < x2 ? 1 : -1 );
+    int dy = -std::abs( y2 - y1 ), sy = ( y1 < y2 ? 1 : -1 );
+    int err = dx + dy;
+    while ( true ) {
+        pset( rgb, x1, y1, r, g, b );
+        if ( x1 == x2 && y1 == y2 ) break;
+        int e2 = 2 * err;
+        if ( e2 >= dy ) { err += dy; x1 += sx; }
+        if ( e2 <= dx ) { err += dx; y1 += sy; }
+    }
+}
+// ====================================================================================================================
+void OffscreenRenderer::render( std::uint8_t* rgb, std::size_t const& compteur )
+{
+    std::memset( rgb, 0, frame_size() );
+
+    // Paysage dans les deux quarts supérieurs
+    for ( int j = 0; j < m_dim; ++j ) {
+        std::uint8_t* row = rgb + 3 * std::size_t( j ) * m_width;
+        const std::uint8_t* land_row = m_land.data() + std::size_t( j ) * m_dim;
+        for ( int i = 0; i < m_dim; ++i ) {
+            std::uint8_t c = land_row[i];
+            std::uint8_t* left  = row + 3 * i;
+            std::uint8_t* right = row + 3 * ( i + m_dim + 10 );
+            left[0] = left[1] = left[2] = c;
+            right[0] = right[1] = right[2] = c;
+        }
+    }
+
+    // Fourmis dans le cadran en haut à gauche
+    for ( auto& ant : m_ref_ants ) {
+        const position_t& pos_ant = ant.get_position( );
+        pset( rgb, pos_ant.x, pos_ant.y, 0, 255, 255 );
+    }
+
+    // Phéronomes dans le cadran en haut à droite
+    for ( int i = 0; i < m_dim; ++i )
+        for ( int j = 0; j < m_dim; ++j ) {
+            double r = std::min( 1., (double)m_ref_phen( i, j )[0] );
+            double g = std::min( 1., (double)m_ref_phen( i, j )[1] );
+            if ( r > 0.01 || g > 0.01 )
+                pset( rgb, i + m_dim + 10, j, static_cast<std::uint8_t>( r * 255 ),
+                      static_cast<std::uint8_t>( g * 255 ), 0 );
+        }
+
+    // Courbe d'enfouragement
+    m_curve.push_back(compteur);
+    if ( m_curve.size( ) > 1 ) {
+        int ydec = m_height - 1;
+        double max_curve_val = *std::max_element( m_curve.begin(), m_curve.end() );
+        double h_max_val = 256. / std::max( max_curve_val, 1.);
+        double step      = double(m_width) / (double)( m_curve.size( ) );
+        for ( std::size_t i = 0; i < m_curve.size( ) - 1; i++ ) {
+            int x1 = static_cast<int>( i * step );
+            int y1 = static_cast<int>( ydec - m_curve[i] * h_max_val );
+            int x2 = static_cast<int>( ( i + 1 ) * step );
+            int y2 = static_cast<int>( ydec - m_curve[i + 1] * h_max_val );
+            line( rgb, x1, y1, x2, y2, 255, 255, 127 );
+        }
+    }
+}
+// ====================================================================================================================
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "fractal_land.hpp"
+#include "ant.hpp"
+#include "pheronome.hpp"
+
+/**
+ * @brief Rendu hors écran de la simulation dans une image RGB ( 3 octets par pixel ) en mémoire
+ * @details Reproduit la mise en page de Renderer ( paysage + fourmis à gauche, paysage + phéronomes à droite,
+ *          courbe de nourriture en bas ) sans fenêtre ni SDL, pour pouvoir enregistrer des images sur un
+ *          nœud de calcul sans affichage.
+ */
+class OffscreenRenderer
+{
+public:
+    OffscreenRenderer( const fractal_land& land, const pheronome& phen, const std::vector<ant>& ants );
+    OffscreenRenderer( const OffscreenRenderer& ) = delete;
+    ~OffscreenRenderer() = default;
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    std::size_t frame_size() const { return 3UL * m_width * m_height; }
+
+    /// Dessine l'état courant dans rgb ( frame_size() octets ) et ajoute compteur à la courbe
+    void render( std::uint8_t* rgb, std::size_t const& compteur );
+private:
+    void pset( std::uint8_t* rgb, int x, int y, std::uint8_t r, std::uint8_t g, std::uint8_t b ) const;
+    void line( std::uint8_t* rgb, int x1, int y1, int x2, int y2,
+               std::uint8_t r, std::uint8_t g, std::uint8_t b ) const;
+
+    fractal_land const& m_ref_land;
+    const pheronome& m_ref_phen;
+    const std::vector<ant>& m_ref_ants;
+    int m_dim, m_width, m_height;
+    std::vector<std::uint8_t> m_land;   // Niveaux de gris du paysage, calculés une seule fois
+    std::vector<std::size_t> m_curve;
+};
@@ -62,14 +62,6 @@ public:
       return m_map_of_pheronome[index(pos)];
     }
 
-    void do_evaporation( ) {
-        for ( std::size_t i = 1; i <= m_dim; ++i )
-            for ( std::size_t j = 1; j <= m_dim; ++j ) {
-                m_buffer_pheronome[i * m_stride + j][0] *= m_beta;
-                m_buffer_pheronome[i * m_stride + j][1] *= m_beta;
-            }
-    }
-
     void mark_pheronome( const position_t& pos ) {
       std::size_t i = pos.x;
       std::size_t j = pos.y;
@@ -96,15 +88,53 @@ public:
         m_buffer_pheronome[( i + 1 ) * m_stride + ( j + 1 )][1] =
             m_alpha * std::max( {v2_left, v2_right, v2_upper, v2_bottom} ) +
             ( 1 - m_alpha ) * 0.25 * ( v2_left + v2_right + v2_upper + v2_bottom );
+        m_marked_cells.push_back( ( i + 1 ) * m_stride + ( j + 1 ) );
     }
 
+    /**
+     * @brief Reporte sur la carte les dépôts faits dans le tampon depuis le dernier appel
+     * @details Seules les cellules marquées par mark_pheronome sont recopiées : le reste du tampon
+     *     n'est jamais relu, il n'a donc pas besoin d'être tenu à jour. Appelé par update( ), mais
+     *     peut l'être avant pour fusionner les cartes de plusieurs processus avant l'évaporation.
+     */
+    void commit_marks( ) {
+        for ( size_t ind : m_marked_cells )
+            m_map_of_pheronome[ind] = m_buffer_pheronome[ind];
+        m_marked_cells.clear( );
+    }
+
+    /**
+     * @brief Termine le pas de temps : dépôts, évaporation, conditions limites et sources
+     * @details Après le report ( creux ) des dépôts, un seul parcours en place de l'intérieur de la carte
+     *     applique l'évaporation et remet la nourriture et la fourmilière à 1. Les cellules fantômes ( -1 )
+     *     ne sont jamais écrites, ni par les fourmis ni ici : elles restent valides depuis le constructeur.
+     *     Les lignes sont réparties entre threads OpenMP quand la carte est assez grande.
+     */
     void update( ) {
-        m_map_of_pheronome.swap( m_buffer_pheronome );
-        cl_update( );
-        m_map_of_pheronome[( m_pos_food.x + 1 ) * m_stride + m_pos_food.y + 1][0] = 1;
-        m_map_of_pheronome[( m_pos_nest.x + 1 ) * m_stride + m_pos_nest.y + 1][1] = 1;
+        commit_marks( );
+        const double      beta    = m_beta;
+        const long        nrows   = static_cast<long>( m_dim );
+        const std::size_t row_len = 2 * m_dim; // Deux phéronomes par cellule, cellules contiguës
+        double*           map     = m_map_of_pheronome.data( )->data( );
+#pragma omp parallel for schedule( static ) if ( m_dim * m_dim >= parallel_threshold )
+        for ( long i = 1; i <= nrows; ++i ) {
+            double* row = map + 2 * ( i * m_stride + 1 );
+#pragma omp simd
+            for ( std::size_t k = 0; k < row_len; ++k )
+                row[k] *= beta;
+        }
+        m_map_of_pheronome[index( m_pos_food )][0] = 1;
+        m_map_of_pheronome[index( m_pos_nest )][1] = 1;
     }
 
+    /**
+     * @brief Accès à la carte complète ( cellules fantômes comprises, size( ) cellules )
+     * @details Utilisé pour fusionner les cartes de plusieurs processus entre commit_marks( ) et update( ).
+     */
+    pheronome_t*       data( ) { return m_map_of_pheronome.data( ); }
+    const pheronome_t* data( ) const { return m_map_of_pheronome.data( ); }
+    std::size_t        size( ) const { return m_map_of_pheronome.size( ); }
+
 private:
     size_t index( const position_t& pos ) const
     {
@@ -125,9 +155,12 @@ private:
             m_map_of_pheronome[j * m_stride + m_dim + 1]     = {{-1., -1.}};
         }
     }
+    // Nombre de cellules au-delà duquel update() est parallélisé
+    static constexpr unsigned long parallel_threshold = 1UL << 20;
     unsigned long              m_dim, m_stride;
     double                     m_alpha, m_beta;
     std::vector< pheronome_t > m_map_of_pheronome, m_buffer_pheronome;
+    std::vector< size_t >      m_marked_cells; // Cellules du tampon écrites depuis le dernier update( )
     position_t m_pos_nest, m_pos_food;
 };
 
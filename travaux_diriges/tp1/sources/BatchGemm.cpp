@@ -0,0 +1,84 @@
+#include <algorithm>
+#include "BatchGemm.hpp"
+#include "Gemm.hpp"
+
+namespace {
+constexpr int MAX_SMALL = 64;
+// En dessous de ce nombre d'opérations pour tout le lot, lancer les threads coûte plus cher que le calcul
+constexpr double parallel_threshold = 1 << 20;
+
+// C = alpha * A * B + beta * C, colonne par colonne : la colonne de C est accumulée dans acc ( registres )
+template <int M, int N, int K>
+void smallGemm(double alpha, const double* A, int ldA, const double* B, int ldB, double beta, double* C,
+               int ldC) {
+  for (int j = 0; j < N; ++j) {
+    double acc[M] = {};
+    for (int p = 0; p < K; ++p) {
+      const double b = B[p + j * ldB];
+      const double* a = A + p * ldA;
+      for (int i = 0; i < M; ++i) acc[i] += a[i] * b;
+    }
+    double* c = C + j * ldC;
+    if (beta == 0.)
+      for (int i = 0; i < M; ++i) c[i] = alpha * acc[i];
+    else
+      for (int i = 0; i < M; ++i) c[i] = alpha * acc[i] + beta * c[i];
+  }
+}
+
+// Même noyau pour des dimensions connues à l'exécution ( m <= MAX_SMALL )
+void smallGemm(int m, int n, int k, double alpha, const double* A, int ldA, const double* B, int ldB,
+               double beta, double* C, int ldC) {
+  for (int j = 0; j < n; ++j) {
+    double acc[MAX_SMALL] = {};
+    for (int p = 0; p < k; ++p) {
+      const double b = B[p + j * ldB];
+      const double* a = A + p * ldA;
+      for (int i = 0; i < m; ++i) acc[i] += a[i] * b;
+    }
+    double* c = C + j * ldC;
+    if (beta == 0.)
+      for (int i = 0; i < m; ++i) c[i] = alpha * acc[i];
+    else
+      for (int i = 0; i < m; ++i) c[i] = alpha * acc[i] + beta * c[i];
+  }
+}
+
+using small_kernel = void (*)(double, const double*, int, const double*, int, double, double*, int);
+
+small_kernel fixedKernel(int m, int n, int k) {
+  if (m != n || n != k) return nullptr;
+  switch (m) {
+  case 4:  return smallGemm<4, 4, 4>;
+  case 8:  return smallGemm<8, 8, 8>;
+  case 16: return smallGemm<16, 16, 16>;
+  case 32: return smallGemm<32, 32, 32>;
+  case 64: return smallGemm<64, 64, 64>;
+  default: return nullptr;
+  }
+}
+}  // namespace
+
+void gemmBatched(int m, int n, int k, double alpha, const double* A, int ldA, long strideA,
+                 const double* B, int ldB, long strideB, double beta, double* C, int ldC, long strideC,
+                 int batchCount) {
+  if (batchCount <= 0 || m <= 0 || n <= 0) return;
+  const small_kernel kernel = fixedKernel(m, n, k);
+  const bool small = (m <= MAX_SMALL);
+  const bool parallel = 2. * m * n * std::max(k, 1) * batchCount >= parallel_threshold;
+#if defined(_OPENMP)
+  #pragma omp parallel for schedule(static) if (parallel)
+#endif
+  for (int b = 0; b < batchCount; ++b) {
+    const double* Ab = A + b * strideA;
+    const double* Bb = B + b * strideB;
+    double* Cb = C + b * strideC;
+    if (kernel)
+      kernel(alpha, Ab, ldA, Bb, ldB, beta, Cb, ldC);
+    else if (small)
+      smallGemm(m, n, k, alpha, Ab, ldA, Bb, ldB, beta, Cb, ldC);
+    else
+      // Dans la région parallèle, la région de gemmPacked ( imbriquée ) n'a qu'un thread
+      gemmPacked<ColMajor, ColMajor, ColMajor>(m, n, k, alpha, Ab, ldA, Bb, ldB, beta, Cb, ldC);
+  }
+}
@@ -0,0 +1,19 @@
+#ifndef _BatchGemm_hpp__
+# define _BatchGemm_hpp__
+
+/**
+ * Lot de petits produits indépendants, rangés par colonnes et espacés d'un pas constant :
+ *
+ *     C_b = alpha * A_b * B_b + beta * C_b,   A_b = A + b*strideA, B_b = B + b*strideB, C_b = C + b*strideC
+ *
+ * pour b = 0 .. batchCount-1, A_b étant m x k, B_b k x n et C_b m x n. Les produits carrés de taille 4, 8, 16,
+ * 32 et 64 utilisent un noyau dont les dimensions sont connues à la compilation ( boucles entièrement
+ * déroulées et vectorisées ), les autres tailles jusqu'à 64 un noyau générique de même forme, au-delà
+ * gemmPacked. Le parallélisme OpenMP porte sur le lot : une seule région parallèle, chaque produit étant
+ * calculé par un seul thread, sans allocation ni lecture de l'environnement. C_b n'est pas lu si beta = 0.
+ */
+void gemmBatched(int m, int n, int k, double alpha, const double* A, int ldA, long strideA,
+                 const double* B, int ldB, long strideB, double beta, double* C, int ldC, long strideC,
+                 int batchCount);
+
+#endif
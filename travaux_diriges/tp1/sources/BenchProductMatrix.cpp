@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <dlfcn.h>
+#include "Matrix.hpp"
+#include "ProdMatMat.hpp"
+
+extern "C" void dgemm_(char const& trA, char const& trB, int const& m, int const& n, int const& k,
+                       double const& alpha, double const* A, int const& ldA, double const* B,
+                       int const& ldB, double const& beta, double* C, int const& ldC );
+
+/*
+ * Balayage des tailles, nombres de threads, tailles de blocs et algorithmes de operator*, comparés à dgemm_
+ * ( BLAS ) pour la même taille et le même nombre de threads. OpenBLAS ignore omp_set_num_threads : son nombre
+ * de threads est fixé par openblas_set_num_threads quand la bibliothèque chargée le fournit. Avec un autre
+ * BLAS, le nombre de threads effectif de dgemm_ est inconnu ( colonne blas à ? ) et le rapport /dgemm le
+ * compare à son propre réglage ( OPENBLAS_NUM_THREADS, OMP_NUM_THREADS, ... ). Chaque mesure est faite après des exécutions de
+ * chauffe et répétée ; on garde le minimum et la médiane ( steady_clock ). L'écart max avec dgemm_ est
+ * vérifié une fois par mesure.
+ *
+ * Usage : ./BenchProductMatrix.exe [--sizes 256,512,1024] [--threads 1,2,4] [--blocks 32,64,128,256]
+ *                                  [--algos naive,block,...,packed,dgemm] [--warmup W] [--reps R]
+ *                                  [--csv resultats.csv] [--json resultats.json]
+ * Les algorithmes séquentiels ( naive, block, strassen ) ne sont mesurés qu'avec le premier nombre de threads ;
+ * la taille de bloc ne concerne que block, parallel_block1 et parallel_block2.
+ * Le JSON contient un enregistrement par ligne, comme bench_kernels du projet.
+ */
+
+namespace {
+using clock_type = std::chrono::steady_clock;
+
+struct BenchResult {
+  int size, threads, blockSize;
+  std::string algo;
+  double min, median;
+  double gflops, gflopsMedian, ratioBlas, maxError;
+  int blasThreads;  // 0 : inconnu
+};
+
+std::vector<int> parseInts(const std::string& arg) {
+  std::vector<int> values;
+  std::stringstream ss(arg);
+  std::string item;
+  while (std::getline(ss, item, ','))
+    if (!item.empty()) values.push_back(std::atoi(item.c_str()));
+  return values;
+}
+
+std::vector<std::string> parseNames(const std::string& arg) {
+  std::vector<std::string> values;
+  std::stringstream ss(arg);
+  std::string item;
+  while (std::getline(ss, item, ','))
+    if (!item.empty()) values.push_back(item);
+  return values;
+}
+
+bool findAlgo(const std::string& name, prod_algo& algo) {
+  for (int a = naive; a <= automatic; ++a)
+    if (name == prodAlgoName(prod_algo(a))) {
+      algo = prod_algo(a);
+      return true;
+    }
+  return false;
+}
+
+/// Fixe le nombre de threads du BLAS s'il est réglable ; retourne le nombre effectif, ou 0 s'il est inconnu
+int setBlasThreads(int n) {
+  using setter = void (*)(int);
+  using getter = int (*)();
+  static const setter set = reinterpret_cast<setter>(dlsym(RTLD_DEFAULT, "openblas_set_num_threads"));
+  static const getter get = reinterpret_cast<getter>(dlsym(RTLD_DEFAULT, "openblas_get_num_threads"));
+  if (set) set(n);
+  return get ? get() : 0;
+}
+
+bool isSequential(prod_algo algo) { return algo == naive || algo == block || algo == strassen; }
+bool usesBlockSize(prod_algo algo) { return algo == block || algo == parallel_block1 || algo == parallel_block2; }
+
+/// Exécute run warmup+reps fois, retourne les temps triés des reps dernières exécutions
+std::vector<double> measure(int warmup, int reps, const std::function<void()>& run) {
+  std::vector<double> times;
+  for (int r = 0; r < warmup + reps; ++r) {
+    auto t0 = clock_type::now();
+    run();
+    auto t1 = clock_type::now();
+    if (r >= warmup) times.push_back(std::chrono::duration<double>(t1 - t0).count());
+  }
+  std::sort(times.begin(), times.end());
+  return times;
+}
+
+double median(const std::vector<double>& sorted) {
+  const std::size_t n = sorted.size();
+  return (n % 2 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]));
+}
+
+double maxDifference(const Matrix& X, const Matrix& Y) {
+  double err = 0.;
+  for (int j = 0; j < X.nbCols; ++j)
+    for (int i = 0; i < X.nbRows; ++i) err = std::max(err, std::fabs(X(i, j) - Y(i, j)));
+  return err;
+}
+}  // namespace
+
+int main(int nargs, char* vargs[]) {
+  std::vector<int> sizes{256, 512, 1024}, threads{1}, blocks{32, 64, 128, 256};
+  std::vector<std::string> algos{"naive", "block", "parallel_naive", "parallel_block1", "parallel_block2",
+                                 "parallel_tasks", "packed", "dgemm"};
+  int warmup = 1, reps = 5;
+  std::string csvName, jsonName;
+  for (int i = 1; i < nargs; ++i) {
+    std::string arg = vargs[i];
+    bool hasValue = (i + 1 < nargs);
+    if (arg == "--sizes" && hasValue) sizes = parseInts(vargs[++i]);
+    else if (arg == "--threads" && hasValue) threads = parseInts(vargs[++i]);
+    else if (arg == "--blocks" && hasValue) blocks = parseInts(vargs[++i]);
+    else if (arg == "--algos" && hasValue) algos = parseNames(vargs[++i]);
+    else if (arg == "--warmup" && hasValue) warmup = std::atoi(vargs[++i]);
+    else if (arg == "--reps" && hasValue) reps = std::max(1, std::atoi(vargs[++i]));
+    else if (arg == "--csv" && hasValue) csvName = vargs[++i];
+    else if (arg == "--json" && hasValue) jsonName = vargs[++i];
+    else {
+      std::cerr << "Option inconnue : " << arg << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  for (const std::string& name : algos) {
+    prod_algo algo;
+    if (name != "dgemm" && !findAlgo(name, algo)) {
+      std::cerr << "Algorithme inconnu : " << name << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<BenchResult> results;
+  std::cout << std::left << std::setw(6) << "n" << std::setw(8) << "threads" << std::setw(17) << "algo"
+            << std::setw(6) << "bloc" << std::right << std::setw(12) << "min (s)" << std::setw(12) << "med (s)"
+            << std::setw(10) << "GFlop/s" << std::setw(9) << "/dgemm" << std::setw(6) << "blas" << std::setw(11)
+            << "erreur" << std::endl;
+  for (int dim : sizes) {
+    Matrix A(dim, dim), B(dim, dim);
+    for (int j = 0; j < dim; ++j)
+      for (int i = 0; i < dim; ++i) {
+        A(i, j) = std::cos(1.67 * i / dim + 0.3 * j);
+        B(i, j) = std::sin(2.03 * j / dim + 0.7 * i);
+      }
+    const double flops = 2. * dim * dim * dim;
+    Matrix ref(dim, dim);
+    dgemm_('N', 'N', dim, dim, dim, 1., A.data(), A.ld(), B.data(), B.ld(), 0., ref.data(), ref.ld());
+
+    for (std::size_t t = 0; t < threads.size(); ++t) {
+      setNbThreads(threads[t]);
+      const int blasThreads = setBlasThreads(threads[t]);
+      const double blasTime =
+          measure(warmup, reps, [&] {
+            Matrix C(dim, dim);
+            dgemm_('N', 'N', dim, dim, dim, 1., A.data(), A.ld(), B.data(), B.ld(), 0., C.data(), C.ld());
+          }).front();
+
+      for (const std::string& name : algos) {
+        prod_algo algo = packed;
+        const bool isBlas = (name == "dgemm");
+        if (!isBlas) {
+          findAlgo(name, algo);
+          if (isSequential(algo) && t > 0) continue;
+        }
+        const std::vector<int> blockSizes = (!isBlas && usesBlockSize(algo)) ? blocks : std::vector<int>{0};
+        for (int blk : blockSizes) {
+          std::vector<double> times;
+          double err = 0.;
+          if (isBlas)
+            times = measure(warmup, reps, [&] {
+              Matrix C(dim, dim);
+              dgemm_('N', 'N', dim, dim, dim, 1., A.data(), A.ld(), B.data(), B.ld(), 0., C.data(), C.ld());
+            });
+          else {
+            err = maxDifference(prodMatMat(A, B, algo, blk), ref);
+            times = measure(warmup, reps, [&] { Matrix C = prodMatMat(A, B, algo, blk); });
+          }
+          BenchResult res{dim, threads[t], blk, name, times.front(), median(times),
+                          flops / times.front() / 1e9, flops / median(times) / 1e9, blasTime / times.front(), err,
+                          blasThreads};
+          results.push_back(res);
+          std::cout << std::left << std::setw(6) << dim << std::setw(8) << threads[t] << std::setw(17) << name
+                    << std::setw(6) << blk << std::right << std::fixed << std::setprecision(5) << std::setw(12)
+                    << res.min << std::setw(12) << res.median << std::setprecision(2) << std::setw(10)
+                    << res.gflops << std::setw(9) << res.ratioBlas << std::setw(6)
+                    << (blasThreads > 0 ? std::to_string(blasThreads) : "?") << std::scientific
+                    << std::setprecision(1)
+                    << std::setw(11) << res.maxError << std::defaultfloat << std::endl;
+        }
+      }
+    }
+  }
+
+  if (!csvName.empty()) {
+    std::ofstream out(csvName);
+    out << "size,threads,algo,block,min_s,median_s,gflops,gflops_median,ratio_dgemm,blas_threads,max_error\n";
+    for (const BenchResult& r : results)
+      out << r.size << "," << r.threads << "," << r.algo << "," << r.blockSize << "," << r.min << "," << r.median
+          << "," << r.gflops << "," << r.gflopsMedian << "," << r.ratioBlas << "," << r.blasThreads << ","
+          << r.maxError << "\n";
+  }
+  if (!jsonName.empty()) {
+    std::ofstream out(jsonName);
+    for (const BenchResult& r : results)
+      out << "{\"size\": " << r.size << ", \"threads\": " << r.threads << ", \"algo\": \"" << r.algo
+          << "\", \"block\": " << r.blockSize << ", \"min_s\": " << r.min << ", \"median_s\": " << r.median
+          << ", \"gflops\": " << r.gflops << ", \"gflops_median\": " << r.gflopsMedian
+          << ", \"ratio_dgemm\": " << r.ratioBlas << ", \"blas_threads\": " << r.blasThreads
+          << ", \"max_error\": " << r.maxError << "}\n";
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cassert>
+#include <vector>
+#include "DistMatrix.hpp"
+#include "Gemm.hpp"
+#include "MatVec.hpp"
+
+ProcessGrid::ProcessGrid(MPI_Comm comm) {
+  int size, rank;
+  MPI_Comm_size(comm, &size);
+  int dims[2] = {0, 0}, periods[2] = {0, 0};
+  MPI_Dims_create(size, 2, dims);
+  MPI_Cart_create(comm, 2, dims, periods, 0, &gridComm);
+  MPI_Comm_rank(gridComm, &rank);
+  int coords[2];
+  MPI_Cart_coords(gridComm, rank, 2, coords);
+  nbRows = dims[0];
+  nbCols = dims[1];
+  myRow = coords[0];
+  myCol = coords[1];
+  // Dans rowComm le rang est la coordonnée de colonne, dans colComm celle de ligne
+  int keepCols[2] = {0, 1}, keepRows[2] = {1, 0};
+  MPI_Cart_sub(gridComm, keepCols, &rowComm);
+  MPI_Cart_sub(gridComm, keepRows, &colComm);
+}
+
+ProcessGrid::~ProcessGrid() {
+  MPI_Comm_free(&rowComm);
+  MPI_Comm_free(&colComm);
+  MPI_Comm_free(&gridComm);
+}
+
+int blockStart(int n, int nbParts, int p) {
+  return p * (n / nbParts) + std::min(p, n % nbParts);
+}
+
+int blockOwner(int n, int nbParts, int i) {
+  const int q = n / nbParts, r = n % nbParts;
+  if (i < r * (q + 1)) return i / (q + 1);
+  return r + (i - r * (q + 1)) / q;
+}
+
+DistMatrix::DistMatrix(const ProcessGrid& grid, int nRows, int nCols)
+    : nbRows{nRows}, nbCols{nCols}, m_grid{&grid},
+      m_local(blockStart(nRows, grid.nbRows, grid.myRow + 1) - blockStart(nRows, grid.nbRows, grid.myRow),
+              blockStart(nCols, grid.nbCols, grid.myCol + 1) - blockStart(nCols, grid.nbCols, grid.myCol)) {}
+
+namespace {
+struct Panel {
+  int k0, kb;
+};
+
+// Frontières des blocs de colonnes de A et des blocs de lignes de B, puis découpe en panneaux d'au plus width
+std::vector<Panel> summaPanels(int k, const ProcessGrid& g, int width) {
+  std::vector<int> cuts;
+  for (int c = 0; c <= g.nbCols; ++c) cuts.push_back(blockStart(k, g.nbCols, c));
+  for (int r = 0; r <= g.nbRows; ++r) cuts.push_back(blockStart(k, g.nbRows, r));
+  std::sort(cuts.begin(), cuts.end());
+  cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+  std::vector<Panel> panels;
+  for (std::size_t c = 0; c + 1 < cuts.size(); ++c)
+    for (int k0 = cuts[c]; k0 < cuts[c + 1]; k0 += width)
+      panels.push_back({k0, std::min(width, cuts[c + 1] - k0)});
+  return panels;
+}
+}  // namespace
+
+void summa(const DistMatrix& A, const DistMatrix& B, DistMatrix& C, int panelWidth) {
+  assert(A.nbCols == B.nbRows && A.nbRows == C.nbRows && B.nbCols == C.nbCols);
+  const ProcessGrid& g = C.grid();
+  const int k = A.nbCols;
+  const int mLoc = C.local().nbRows, nLoc = C.local().nbCols;
+  const std::vector<Panel> panels = summaPanels(k, g, std::max(1, panelWidth));
+  if (panels.empty()) return;
+
+  int kbMax = 0;
+  for (const Panel& p : panels) kbMax = std::max(kbMax, p.kb);
+  std::vector<double> Abuf[2], Bbuf[2];
+  for (int s = 0; s < 2; ++s) {
+    Abuf[s].resize(std::size_t(mLoc) * kbMax);
+    Bbuf[s].resize(std::size_t(kbMax) * nLoc);
+  }
+  MPI_Request requests[2][2];
+
+  // Le propriétaire recopie son panneau ( A : mLoc x kb, B : kb x nLoc, rangés par colonnes ) puis le diffuse
+  auto startPanel = [&](int t, int s) {
+    const Panel& p = panels[t];
+    const int ownerCol = blockOwner(k, g.nbCols, p.k0);
+    const int ownerRow = blockOwner(k, g.nbRows, p.k0);
+    if (g.myCol == ownerCol) {
+      const Matrix& Al = A.local();
+      const int kl = p.k0 - A.colOffset();
+      for (int j = 0; j < p.kb; ++j)
+        std::copy_n(Al.data() + std::size_t(kl + j) * Al.ld(), mLoc, Abuf[s].data() + std::size_t(j) * mLoc);
+    }
+    if (g.myRow == ownerRow) {
+      const Matrix& Bl = B.local();
+      const int kl = p.k0 - B.rowOffset();
+      for (int j = 0; j < nLoc; ++j)
+        std::copy_n(Bl.data() + kl + std::size_t(j) * Bl.ld(), p.kb, Bbuf[s].data() + std::size_t(j) * p.kb);
+    }
+    MPI_Ibcast(Abuf[s].data(), mLoc * p.kb, MPI_DOUBLE, ownerCol, g.rowComm, &requests[s][0]);
+    MPI_Ibcast(Bbuf[s].data(), p.kb * nLoc, MPI_DOUBLE, ownerRow, g.colComm, &requests[s][1]);
+  };
+
+  startPanel(0, 0);
+  for (std::size_t t = 0; t < panels.size(); ++t) {
+    const int s = t % 2;
+    // Le tampon 1-s a servi au panneau t-1, déjà multiplié : on peut y recevoir le panneau t+1
+    if (t + 1 < panels.size()) startPanel(t + 1, 1 - s);
+    MPI_Waitall(2, requests[s], MPI_STATUSES_IGNORE);
+    gemmPacked(mLoc, nLoc, panels[t].kb, Abuf[s].data(), mLoc, Bbuf[s].data(), panels[t].kb,
+               C.local().data(), C.local().ld());
+  }
+}
+
+namespace {
+// Tailles et débuts des tranches des nbp processus
+void sliceCounts(int n, int nbp, std::vector<int>& counts, std::vector<int>& displs) {
+  counts.resize(nbp);
+  displs.resize(nbp);
+  for (int r = 0; r < nbp; ++r) {
+    displs[r] = blockStart(n, nbp, r);
+    counts[r] = blockStart(n, nbp, r + 1) - displs[r];
+  }
+}
+}  // namespace
+
+void matvecRowBlock(int m, const Matrix& ALoc, const std::vector<double>& x, std::vector<double>& y,
+                    MPI_Comm comm) {
+  int nbp, rank;
+  MPI_Comm_size(comm, &nbp);
+  MPI_Comm_rank(comm, &rank);
+  assert(int(x.size()) == ALoc.nbCols);
+  std::vector<int> counts, displs;
+  sliceCounts(m, nbp, counts, displs);
+  assert(ALoc.nbRows == counts[rank]);
+  y.resize(m);
+  // La tranche locale est calculée directement à sa place dans y
+  gemv(1., ALoc.view(), x.data(), 0., y.data() + displs[rank]);
+  MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, y.data(), counts.data(), displs.data(), MPI_DOUBLE, comm);
+}
+
+void matvecColBlock(const Matrix& ALoc, const std::vector<double>& xLoc, std::vector<double>& yLoc,
+                    MPI_Comm comm) {
+  int nbp, rank;
+  MPI_Comm_size(comm, &nbp);
+  MPI_Comm_rank(comm, &rank);
+  const int m = ALoc.nbRows;
+  assert(int(xLoc.size()) == ALoc.nbCols);
+  std::vector<int> counts, displs;
+  sliceCounts(m, nbp, counts, displs);
+  std::vector<double> partial(m);
+  gemv(1., ALoc.view(), xLoc.data(), 0., partial.data());
+  yLoc.resize(counts[rank]);
+  MPI_Reduce_scatter(partial.data(), yLoc.data(), counts.data(), MPI_DOUBLE, MPI_SUM, comm);
+}
@@ -0,0 +1,83 @@
+#ifndef _DistMatrix_hpp__
+# define _DistMatrix_hpp__
+# include <mpi.h>
+# include <vector>
+# include "Matrix.hpp"
+
+/**
+ * Grille 2D de processus pr x pc ( dimensions choisies par MPI_Dims_create ) avec les communicateurs
+ * de ligne ( processus de même myRow ) et de colonne ( même myCol ).
+ */
+class ProcessGrid
+{
+public:
+  explicit ProcessGrid(MPI_Comm comm);
+  ProcessGrid(const ProcessGrid&) = delete;
+  ProcessGrid& operator=(const ProcessGrid&) = delete;
+  ~ProcessGrid();
+
+  int nbRows, nbCols;  // dimensions de la grille
+  int myRow, myCol;    // coordonnées du processus courant
+  MPI_Comm gridComm, rowComm, colComm;
+};
+
+/// Début de la tranche p lorsque n indices sont répartis en nbParts tranches équilibrées ( p = nbParts -> n )
+int blockStart(int n, int nbParts, int p);
+/// Tranche contenant l'indice i
+int blockOwner(int n, int nbParts, int i);
+
+/**
+ * Matrice nbRows x nbCols distribuée par blocs sur une grille de processus : le processus (r,c) possède
+ * les lignes [rowOffset(), rowOffset()+local().nbRows) et les colonnes [colOffset(), colOffset()+local().nbCols),
+ * stockées dans une Matrix locale ( rangée par colonnes ).
+ */
+class DistMatrix
+{
+public:
+  DistMatrix(const ProcessGrid& grid, int nRows, int nCols);
+
+  const ProcessGrid& grid() const { return *m_grid; }
+  Matrix& local() { return m_local; }
+  const Matrix& local() const { return m_local; }
+  int rowOffset() const { return blockStart(nbRows, m_grid->nbRows, m_grid->myRow); }
+  int colOffset() const { return blockStart(nbCols, m_grid->nbCols, m_grid->myCol); }
+
+  int nbRows, nbCols;  // dimensions globales
+private:
+  const ProcessGrid* m_grid;
+  Matrix m_local;
+};
+
+/**
+ * C += A * B par l'algorithme SUMMA. La dimension k est découpée en panneaux aux frontières des blocs de
+ * colonnes de A et des blocs de lignes de B ( chaque panneau a un seul propriétaire de chaque côté ), au
+ * plus panelWidth colonnes. Pour chaque panneau, le propriétaire diffuse sa partie de A le long de sa ligne
+ * de processus et sa partie de B le long de sa colonne ( MPI_Ibcast ) ; la diffusion du panneau suivant est
+ * lancée avant le produit local du panneau courant ( gemmPacked, parallélisé avec OpenMP ), avec deux tampons
+ * par opérande.
+ */
+void summa(const DistMatrix& A, const DistMatrix& B, DistMatrix& C, int panelWidth = 256);
+
+/**
+ * Produits matrice-vecteur y = A * x distribués sur les nbp processus de comm, A de taille m x n quelconque ;
+ * une dimension d est découpée en tranches [blockStart(d,nbp,r), blockStart(d,nbp,r+1)) et le produit local
+ * est gemv ( MatVec.hpp ).
+ *
+ * Par blocs de lignes : ALoc contient les lignes de la tranche de m du processus ( toutes les colonnes ), x est
+ * complet sur chaque processus. Chacun calcule sa tranche de y, puis MPI_Allgatherv rassemble y complet
+ * partout ( m doubles reçus par processus ). Le nombre total de lignes m n'est pas connu localement : il est
+ * passé explicitement.
+ */
+void matvecRowBlock(int m, const Matrix& ALoc, const std::vector<double>& x, std::vector<double>& y,
+                    MPI_Comm comm);
+
+/**
+ * Par blocs de colonnes : ALoc contient une tranche de colonnes ( toutes les m lignes ) et xLoc la tranche
+ * correspondante de x. Chacun calcule la contribution ALoc * xLoc à y entier, et MPI_Reduce_scatter somme ces
+ * contributions en laissant à chaque processus la tranche yLoc de y ( tranches de m ). Si A est carrée et x
+ * découpé en tranches de n, y est distribué comme x, prêt pour l'itération suivante d'un solveur.
+ */
+void matvecColBlock(const Matrix& ALoc, const std::vector<double>& xLoc, std::vector<double>& yLoc,
+                    MPI_Comm comm);
+
+#endif
@@ -0,0 +1,424 @@
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <unistd.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+#include "Gemm.hpp"
+
+namespace {
+// Taille du bloc de C gardé dans les registres, selon le type P des tampons recopiés et du calcul :
+// MR = 2 registres AVX ( 4 doubles ou 8 floats chacun ), NR = 6 colonnes ( 12 accumulateurs )
+template <typename P> struct MicroTile;
+template <> struct MicroTile<double> {
+  static constexpr int MR = 8, NR = 6;
+};
+template <> struct MicroTile<float> {
+  static constexpr int MR = 16, NR = 6;
+};
+constexpr std::size_t ALIGN = 64;
+
+struct FreeDeleter {
+  void operator()(void* p) const { std::free(p); }
+};
+template <typename P> using aligned_buffer = std::unique_ptr<P[], FreeDeleter>;
+
+template <typename P> aligned_buffer<P> allocAligned(std::size_t nb) {
+  void* p = nullptr;
+  if (posix_memalign(&p, ALIGN, std::max<std::size_t>(nb, 1) * sizeof(P)) != 0)
+    throw std::bad_alloc();
+  return aligned_buffer<P>(static_cast<P*>(p));
+}
+
+long cacheSize(int name, long fallback) {
+  long sz = sysconf(name);
+  return (sz > 0 ? sz : fallback);
+}
+
+// Dans tout ce qui suit, T est le type des coefficients stockés ( A, B et C ) et P celui des tampons recopiés
+// et des accumulateurs : P = T, ou P = double pour T = float ( précision mixte, conversion lors de la copie ).
+
+// Copie le bloc alpha*A(0:mc,0:kc) en micro-bandes de MR lignes : Ap[ir*kc + p*MR + i] ( complété par des zéros ).
+// Si A est rangée par lignes, on lit chaque ligne à pas unitaire.
+template <typename LA, typename P, typename T>
+void packA(int mc, int kc, P alpha, const T* A, int ldA, P* Ap) {
+  constexpr int MR = MicroTile<P>::MR;
+  for (int ir = 0; ir < mc; ir += MR) {
+    const int mr = std::min(MR, mc - ir);
+    P* dst = Ap + ir * kc;
+    if (LA::isColMajor) {
+      for (int p = 0; p < kc; ++p) {
+        const T* src = A + ir + p * ldA;
+        for (int i = 0; i < mr; ++i) dst[i] = alpha * P(src[i]);
+        for (int i = mr; i < MR; ++i) dst[i] = P(0);
+        dst += MR;
+      }
+    } else {
+      for (int i = 0; i < mr; ++i) {
+        const T* src = A + (ir + i) * ldA;
+        for (int p = 0; p < kc; ++p) dst[p * MR + i] = alpha * P(src[p]);
+      }
+      for (int i = mr; i < MR; ++i)
+        for (int p = 0; p < kc; ++p) dst[p * MR + i] = P(0);
+    }
+  }
+}
+
+// Copie la micro-bande B(0:kc, 0:nr) : Bp[p*NR + j] ( complétée par des zéros ). Si B est rangée par lignes,
+// lecture et écriture sont à pas unitaire.
+template <typename LB, typename P, typename T>
+void packBPanel(int nr, int kc, const T* B, int ldB, P* Bp) {
+  constexpr int NR = MicroTile<P>::NR;
+  if (LB::isColMajor) {
+    for (int j = 0; j < nr; ++j) {
+      const T* src = B + j * ldB;
+      for (int p = 0; p < kc; ++p) Bp[p * NR + j] = P(src[p]);
+    }
+    for (int j = nr; j < NR; ++j)
+      for (int p = 0; p < kc; ++p) Bp[p * NR + j] = P(0);
+  } else {
+    for (int p = 0; p < kc; ++p) {
+      const T* src = B + p * ldB;
+      for (int j = 0; j < nr; ++j) Bp[j] = P(src[j]);
+      for (int j = nr; j < NR; ++j) Bp[j] = P(0);
+      Bp += NR;
+    }
+  }
+}
+
+// C(0:mr,0:nr) = beta*C + tile, la tuile étant rangée par colonnes ( tile[j*MR + i] ). C n'est pas lu si beta = 0.
+// C est parcouru à pas unitaire ( colonne par colonne en ColMajor, ligne par ligne en RowMajor ) ; la somme est
+// faite en P avant l'arrondi éventuel vers T.
+template <typename LC, typename P, typename T>
+void addTile(const P* tile, P beta, T* C, int ldC, int mr, int nr) {
+  constexpr int MR = MicroTile<P>::MR;
+  const int nOuter = LC::isColMajor ? nr : mr, nInner = LC::isColMajor ? mr : nr;
+  const int tOuter = LC::isColMajor ? MR : 1, tInner = LC::isColMajor ? 1 : MR;
+  for (int o = 0; o < nOuter; ++o) {
+    T* c = C + o * ldC;
+    const P* t = tile + o * tOuter;
+    if (beta == P(1))
+      for (int x = 0; x < nInner; ++x) c[x] = T(P(c[x]) + t[x * tInner]);
+    else if (beta == P(0))
+      for (int x = 0; x < nInner; ++x) c[x] = T(t[x * tInner]);
+    else
+      for (int x = 0; x < nInner; ++x) c[x] = T(beta * P(c[x]) + t[x * tInner]);
+  }
+}
+
+// C(0:m,0:n) = beta*C, quand il n'y a rien à ajouter ( k = 0 ou alpha = 0 )
+template <typename LC, typename P, typename T> void scaleC(int m, int n, P beta, T* C, int ldC) {
+  if (beta == P(1)) return;
+  for (int i = 0; i < m; ++i)
+    for (int j = 0; j < n; ++j) {
+      T& c = C[LC::index(i, j, ldC)];
+      c = (beta == P(0) ? T(0) : T(beta * P(c)));
+    }
+}
+
+// tile = Ap * Bp sur kc termes ( tuile MR x NR rangée par colonnes )
+template <typename P> void tileProduct(int kc, const P* Ap, const P* Bp, P* tile) {
+  constexpr int MR = MicroTile<P>::MR, NR = MicroTile<P>::NR;
+  for (int i = 0; i < MR * NR; ++i) tile[i] = P(0);
+  for (int p = 0; p < kc; ++p) {
+    for (int j = 0; j < NR; ++j) {
+      const P b = Bp[j];
+      for (int i = 0; i < MR; ++i) tile[j * MR + i] += Ap[i] * b;
+    }
+    Ap += MR;
+    Bp += NR;
+  }
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+template <> void tileProduct<double>(int kc, const double* Ap, const double* Bp, double* tile) {
+  constexpr int MR = MicroTile<double>::MR, NR = MicroTile<double>::NR;
+  __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+  __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+  __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+  __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+  __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+  __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+  for (int p = 0; p < kc; ++p) {
+    const __m256d a0 = _mm256_load_pd(Ap);
+    const __m256d a1 = _mm256_load_pd(Ap + 4);
+    __m256d b = _mm256_broadcast_sd(Bp);
+    c00 = _mm256_fmadd_pd(a0, b, c00); c01 = _mm256_fmadd_pd(a1, b, c01);
+    b = _mm256_broadcast_sd(Bp + 1);
+    c10 = _mm256_fmadd_pd(a0, b, c10); c11 = _mm256_fmadd_pd(a1, b, c11);
+    b = _mm256_broadcast_sd(Bp + 2);
+    c20 = _mm256_fmadd_pd(a0, b, c20); c21 = _mm256_fmadd_pd(a1, b, c21);
+    b = _mm256_broadcast_sd(Bp + 3);
+    c30 = _mm256_fmadd_pd(a0, b, c30); c31 = _mm256_fmadd_pd(a1, b, c31);
+    b = _mm256_broadcast_sd(Bp + 4);
+    c40 = _mm256_fmadd_pd(a0, b, c40); c41 = _mm256_fmadd_pd(a1, b, c41);
+    b = _mm256_broadcast_sd(Bp + 5);
+    c50 = _mm256_fmadd_pd(a0, b, c50); c51 = _mm256_fmadd_pd(a1, b, c51);
+    Ap += MR;
+    Bp += NR;
+  }
+  _mm256_store_pd(tile + 0 * MR, c00); _mm256_store_pd(tile + 0 * MR + 4, c01);
+  _mm256_store_pd(tile + 1 * MR, c10); _mm256_store_pd(tile + 1 * MR + 4, c11);
+  _mm256_store_pd(tile + 2 * MR, c20); _mm256_store_pd(tile + 2 * MR + 4, c21);
+  _mm256_store_pd(tile + 3 * MR, c30); _mm256_store_pd(tile + 3 * MR + 4, c31);
+  _mm256_store_pd(tile + 4 * MR, c40); _mm256_store_pd(tile + 4 * MR + 4, c41);
+  _mm256_store_pd(tile + 5 * MR, c50); _mm256_store_pd(tile + 5 * MR + 4, c51);
+}
+
+// Même schéma en simple précision : 8 floats par registre, soit deux fois plus de lignes de C par tuile
+template <> void tileProduct<float>(int kc, const float* Ap, const float* Bp, float* tile) {
+  constexpr int MR = MicroTile<float>::MR, NR = MicroTile<float>::NR;
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+  __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+  __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+  for (int p = 0; p < kc; ++p) {
+    const __m256 a0 = _mm256_load_ps(Ap);
+    const __m256 a1 = _mm256_load_ps(Ap + 8);
+    __m256 b = _mm256_broadcast_ss(Bp);
+    c00 = _mm256_fmadd_ps(a0, b, c00); c01 = _mm256_fmadd_ps(a1, b, c01);
+    b = _mm256_broadcast_ss(Bp + 1);
+    c10 = _mm256_fmadd_ps(a0, b, c10); c11 = _mm256_fmadd_ps(a1, b, c11);
+    b = _mm256_broadcast_ss(Bp + 2);
+    c20 = _mm256_fmadd_ps(a0, b, c20); c21 = _mm256_fmadd_ps(a1, b, c21);
+    b = _mm256_broadcast_ss(Bp + 3);
+    c30 = _mm256_fmadd_ps(a0, b, c30); c31 = _mm256_fmadd_ps(a1, b, c31);
+    b = _mm256_broadcast_ss(Bp + 4);
+    c40 = _mm256_fmadd_ps(a0, b, c40); c41 = _mm256_fmadd_ps(a1, b, c41);
+    b = _mm256_broadcast_ss(Bp + 5);
+    c50 = _mm256_fmadd_ps(a0, b, c50); c51 = _mm256_fmadd_ps(a1, b, c51);
+    Ap += MR;
+    Bp += NR;
+  }
+  _mm256_store_ps(tile + 0 * MR, c00); _mm256_store_ps(tile + 0 * MR + 8, c01);
+  _mm256_store_ps(tile + 1 * MR, c10); _mm256_store_ps(tile + 1 * MR + 8, c11);
+  _mm256_store_ps(tile + 2 * MR, c20); _mm256_store_ps(tile + 2 * MR + 8, c21);
+  _mm256_store_ps(tile + 3 * MR, c30); _mm256_store_ps(tile + 3 * MR + 8, c31);
+  _mm256_store_ps(tile + 4 * MR, c40); _mm256_store_ps(tile + 4 * MR + 8, c41);
+  _mm256_store_ps(tile + 5 * MR, c50); _mm256_store_ps(tile + 5 * MR + 8, c51);
+}
+#endif
+
+// C(0:mr,0:nr) = beta*C + Ap * Bp sur kc termes
+template <typename LC, typename P, typename T>
+void microKernel(int kc, const P* Ap, const P* Bp, P beta, T* C, int ldC, int mr, int nr) {
+  alignas(ALIGN) P tile[MicroTile<P>::MR * MicroTile<P>::NR];
+  tileProduct(kc, Ap, Bp, tile);
+  addTile<LC>(tile, beta, C, ldC, mr, nr);
+}
+
+// C(0:mc,0:nc) = beta*C + Ap(mc x kc) * Bp(kc x nc), les deux blocs étant déjà recopiés
+template <typename LC, typename P, typename T>
+void macroKernel(int mc, int nc, int kc, const P* Ap, const P* Bp, P beta, T* C, int ldC) {
+  constexpr int MR = MicroTile<P>::MR, NR = MicroTile<P>::NR;
+  for (int jr = 0; jr < nc; jr += NR) {
+    const int nr = std::min(NR, nc - jr);
+    for (int ir = 0; ir < mc; ir += MR) {
+      const int mr = std::min(MR, mc - ir);
+      microKernel<LC>(kc, Ap + ir * kc, Bp + jr * kc, beta, C + LC::index(ir, jr, ldC), ldC, mr, nr);
+    }
+  }
+}
+
+/**
+ * C = alpha * A * B + beta * C, coefficients de type T, calcul en P. En précision mixte, chaque bloc de kc
+ * termes est accumulé en double avant d'être ajouté à C : C n'est arrondi qu'une fois par bloc de k.
+ */
+template <typename P, typename LA, typename LB, typename LC, typename T>
+void packedProduct(int m, int n, int k, P alpha, const T* A, int ldA, const T* B, int ldB, P beta, T* C,
+                   int ldC, const GemmBlocking& blocking) {
+  constexpr int MR = MicroTile<P>::MR, NR = MicroTile<P>::NR;
+  if (m <= 0 || n <= 0) return;
+  if (k <= 0 || alpha == P(0)) {
+    scaleC<LC>(m, n, beta, C, ldC);
+    return;
+  }
+  // Les copies sont complétées jusqu'à des micro-bandes entières : tampons arrondis à MR et NR, même si la
+  // taille de bloc demandée n'en est pas un multiple
+  const int kcMax = std::min(blocking.kc, k);
+  const int ncMax = (std::min(blocking.nc, n) + NR - 1) / NR * NR;
+  const int mcMax = (std::min(blocking.mc, m) + MR - 1) / MR * MR;
+  aligned_buffer<P> Bp = allocAligned<P>(std::size_t(kcMax) * ncMax);
+
+#if defined(_OPENMP)
+  #pragma omp parallel
+#endif
+  {
+    // Chaque thread recopie ses propres blocs de A, le bloc de B est partagé
+    aligned_buffer<P> Ap = allocAligned<P>(std::size_t(kcMax) * mcMax);
+    for (int jc = 0; jc < n; jc += blocking.nc) {
+      const int nc = std::min(blocking.nc, n - jc);
+      for (int pc = 0; pc < k; pc += blocking.kc) {
+        const int kc = std::min(blocking.kc, k - pc);
+        // beta n'est appliqué qu'au premier bloc de k, les suivants s'ajoutent
+        const P betaPanel = (pc == 0 ? beta : P(1));
+#if defined(_OPENMP)
+        #pragma omp for schedule(static)
+#endif
+        for (int jr = 0; jr < nc; jr += NR)
+          packBPanel<LB>(std::min(NR, nc - jr), kc, B + LB::index(pc, jc + jr, ldB), ldB, Bp.get() + jr * kc);
+#if defined(_OPENMP)
+        #pragma omp for schedule(dynamic)
+#endif
+        for (int ic = 0; ic < m; ic += blocking.mc) {
+          const int mc = std::min(blocking.mc, m - ic);
+          packA<LA>(mc, kc, alpha, A + LA::index(ic, pc, ldA), ldA, Ap.get());
+          macroKernel<LC>(mc, nc, kc, Ap.get(), Bp.get(), betaPanel, C + LC::index(ic, jc, ldC), ldC);
+        }
+      }
+    }
+  }
+}
+
+// op(X) = X^T lue dans un tableau rangé par colonnes est une matrice rangée par lignes de même ld
+bool isTransposed(char tr) { return tr == 'T' || tr == 't' || tr == 'C' || tr == 'c'; }
+
+template <typename T>
+void gemmDispatch(char trA, char trB, int m, int n, int k, T alpha, const T* A, int ldA, const T* B, int ldB,
+                  T beta, T* C, int ldC) {
+  const bool tA = isTransposed(trA), tB = isTransposed(trB);
+  if (!tA && !tB)
+    gemmPacked<ColMajor, ColMajor, ColMajor>(m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC);
+  else if (!tA)
+    gemmPacked<ColMajor, RowMajor, ColMajor>(m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC);
+  else if (!tB)
+    gemmPacked<RowMajor, ColMajor, ColMajor>(m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC);
+  else
+    gemmPacked<RowMajor, RowMajor, ColMajor>(m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC);
+}
+}  // namespace
+
+template <typename T> int gemmMicroRows() { return MicroTile<T>::MR; }
+template <typename T> int gemmMicroCols() { return MicroTile<T>::NR; }
+
+template <typename T> GemmBlocking gemmDefaultBlocking() {
+  static const GemmBlocking blocking = [] {
+    constexpr long MR = MicroTile<T>::MR, NR = MicroTile<T>::NR, sz = sizeof(T);
+    const long l1 = cacheSize(_SC_LEVEL1_DCACHE_SIZE, 32L << 10);
+    const long l2 = cacheSize(_SC_LEVEL2_CACHE_SIZE, 256L << 10);
+    const long l3 = cacheSize(_SC_LEVEL3_CACHE_SIZE, 8L << 20);
+    GemmBlocking blk;
+    // Micro-bande de B ( kc x NR ) dans la moitié du L1, le reste pour les micro-bandes de A qui défilent
+    blk.kc = std::max(64L, std::min(4096L / sz, (l1 / 2) / (NR * sz) / 8 * 8));
+    // Bloc de A ( mc x kc ) dans la moitié du L2
+    blk.mc = std::max(MR, std::min(1024L, (l2 / 2) / (blk.kc * sz) / MR * MR));
+    // Bloc de B ( kc x nc ) dans la moitié du L3
+    blk.nc = std::max(NR, std::min(4080L, (l3 / 2) / (blk.kc * sz) / NR * NR));
+    return blk;
+  }();
+  return blocking;
+}
+
+template int gemmMicroRows<double>();
+template int gemmMicroRows<float>();
+template int gemmMicroCols<double>();
+template int gemmMicroCols<float>();
+template GemmBlocking gemmDefaultBlocking<double>();
+template GemmBlocking gemmDefaultBlocking<float>();
+
+void gemmPacked(int m, int n, int k, const double* A, int ldA, const double* B, int ldB,
+                double* C, int ldC) {
+  gemmPacked<ColMajor, ColMajor, ColMajor>(m, n, k, 1., A, ldA, B, ldB, 1., C, ldC, gemmDefaultBlocking());
+}
+
+void gemmPacked(int m, int n, int k, const double* A, int ldA, const double* B, int ldB,
+                double* C, int ldC, const GemmBlocking& blocking) {
+  gemmPacked<ColMajor, ColMajor, ColMajor>(m, n, k, 1., A, ldA, B, ldB, 1., C, ldC, blocking);
+}
+
+void gemmPacked(int m, int n, int k, const float* A, int ldA, const float* B, int ldB, float* C, int ldC) {
+  gemmPacked<ColMajor, ColMajor, ColMajor>(m, n, k, 1.f, A, ldA, B, ldB, 1.f, C, ldC,
+                                           gemmDefaultBlocking<float>());
+}
+
+void gemm(char trA, char trB, int m, int n, int k, double alpha, const double* A, int ldA,
+          const double* B, int ldB, double beta, double* C, int ldC) {
+  gemmDispatch(trA, trB, m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC);
+}
+
+void gemm(char trA, char trB, int m, int n, int k, float alpha, const float* A, int ldA,
+          const float* B, int ldB, float beta, float* C, int ldC) {
+  gemmDispatch(trA, trB, m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC);
+}
+
+template <typename LA, typename LB, typename LC>
+void gemmPacked(int m, int n, int k, double alpha, const double* A, int ldA, const double* B, int ldB,
+                double beta, double* C, int ldC, const GemmBlocking& blocking) {
+  packedProduct<double, LA, LB, LC>(m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC, blocking);
+}
+
+template <typename LA, typename LB, typename LC>
+void gemmPacked(int m, int n, int k, double alpha, const double* A, int ldA, const double* B, int ldB,
+                double beta, double* C, int ldC) {
+  gemmPacked<LA, LB, LC>(m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC, gemmDefaultBlocking());
+}
+
+template <typename LA, typename LB, typename LC>
+void gemmPacked(int m, int n, int k, const double* A, int ldA, const double* B, int ldB,
+                double* C, int ldC, const GemmBlocking& blocking) {
+  gemmPacked<LA, LB, LC>(m, n, k, 1., A, ldA, B, ldB, 1., C, ldC, blocking);
+}
+
+template <typename LA, typename LB, typename LC>
+void gemmPacked(int m, int n, int k, const double* A, int ldA, const double* B, int ldB,
+                double* C, int ldC) {
+  gemmPacked<LA, LB, LC>(m, n, k, 1., A, ldA, B, ldB, 1., C, ldC, gemmDefaultBlocking());
+}
+
+template <typename LA, typename LB, typename LC>
+void gemmPacked(int m, int n, int k, float alpha, const float* A, int ldA, const float* B, int ldB,
+                float beta, float* C, int ldC, const GemmBlocking& blocking) {
+  packedProduct<float, LA, LB, LC>(m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC, blocking);
+}
+
+template <typename LA, typename LB, typename LC>
+void gemmPacked(int m, int n, int k, float alpha, const float* A, int ldA, const float* B, int ldB,
+                float beta, float* C, int ldC) {
+  gemmPacked<LA, LB, LC>(m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC, gemmDefaultBlocking<float>());
+}
+
+template <typename LA, typename LB, typename LC>
+void gemmPackedMixed(int m, int n, int k, double alpha, const float* A, int ldA, const float* B, int ldB,
+                     double beta, float* C, int ldC, const GemmBlocking& blocking) {
+  packedProduct<double, LA, LB, LC>(m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC, blocking);
+}
+
+template <typename LA, typename LB, typename LC>
+void gemmPackedMixed(int m, int n, int k, double alpha, const float* A, int ldA, const float* B, int ldB,
+                     double beta, float* C, int ldC) {
+  gemmPackedMixed<LA, LB, LC>(m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC, gemmDefaultBlocking());
+}
+
+// Les huit combinaisons de rangements, pour chaque précision
+#define GEMM_INSTANTIATE(LA, LB, LC)                                                                    \
+  template void gemmPacked<LA, LB, LC>(int, int, int, const double*, int, const double*, int,           \
+                                       double*, int, const GemmBlocking&);                               \
+  template void gemmPacked<LA, LB, LC>(int, int, int, const double*, int, const double*, int,           \
+                                       double*, int);                                                    \
+  template void gemmPacked<LA, LB, LC>(int, int, int, double, const double*, int, const double*, int,    \
+                                       double, double*, int, const GemmBlocking&);                       \
+  template void gemmPacked<LA, LB, LC>(int, int, int, double, const double*, int, const double*, int,    \
+                                       double, double*, int);                                            \
+  template void gemmPacked<LA, LB, LC>(int, int, int, float, const float*, int, const float*, int,       \
+                                       float, float*, int, const GemmBlocking&);                         \
+  template void gemmPacked<LA, LB, LC>(int, int, int, float, const float*, int, const float*, int,       \
+                                       float, float*, int);                                              \
+  template void gemmPackedMixed<LA, LB, LC>(int, int, int, double, const float*, int, const float*, int, \
+                                            double, float*, int, const GemmBlocking&);                   \
+  template void gemmPackedMixed<LA, LB, LC>(int, int, int, double, const float*, int, const float*, int, \
+                                            double, float*, int);
+GEMM_INSTANTIATE(ColMajor, ColMajor, ColMajor)
+GEMM_INSTANTIATE(ColMajor, ColMajor, RowMajor)
+GEMM_INSTANTIATE(ColMajor, RowMajor, ColMajor)
+GEMM_INSTANTIATE(ColMajor, RowMajor, RowMajor)
+GEMM_INSTANTIATE(RowMajor, ColMajor, ColMajor)
+GEMM_INSTANTIATE(RowMajor, ColMajor, RowMajor)
+GEMM_INSTANTIATE(RowMajor, RowMajor, ColMajor)
+GEMM_INSTANTIATE(RowMajor, RowMajor, RowMajor)
+#undef GEMM_INSTANTIATE
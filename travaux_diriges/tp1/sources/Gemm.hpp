@@ -0,0 +1,87 @@
+#ifndef _Gemm_hpp__
+# define _Gemm_hpp__
+# include "Layout.hpp"
+
+/**
+ * Produit matrice-matrice "à la BLIS" sur des tableaux stockés par colonnes :
+ *
+ *     C(0:m,0:n) += A(0:m,0:k) * B(0:k,0:n)
+ *
+ * avec X(i,j) = X[i + j*ldX]. Trois niveaux de blocs ( nc colonnes de B et C, kc colonnes de A,
+ * mc lignes de A et C ) sont choisis pour que le bloc de B ( kc x nc ) tienne dans le cache L3, le bloc de A
+ * ( mc x kc ) dans le L2 et une micro-bande de B ( kc x NR ) dans le L1. Les blocs de A et B sont recopiés
+ * ( "packing" ) dans des tampons contigus et alignés, parcourus à pas unitaire par un micro-noyau qui garde
+ * un bloc MR x NR de C dans les registres ( FMA AVX2 si disponible ).
+ */
+struct GemmBlocking
+{
+  int mc, kc, nc;
+};
+
+/// Tailles de blocs déduites des tailles de caches de la machine ( calculées une seule fois par type )
+template <typename T = double> GemmBlocking gemmDefaultBlocking();
+
+/// Hauteur ( MR ) et largeur ( NR ) du bloc de C calculé par le micro-noyau ( MR = 8 en double, 16 en float )
+template <typename T = double> int gemmMicroRows();
+template <typename T = double> int gemmMicroCols();
+
+void gemmPacked(int m, int n, int k, const double* A, int ldA, const double* B, int ldB,
+                double* C, int ldC);
+void gemmPacked(int m, int n, int k, const double* A, int ldA, const double* B, int ldB,
+                double* C, int ldC, const GemmBlocking& blocking);
+/// Simple précision : même moteur, micro-noyau de 16 x 6 floats
+void gemmPacked(int m, int n, int k, const float* A, int ldA, const float* B, int ldB, float* C, int ldC);
+
+/**
+ * Même produit pour des rangements quelconques de A, B et C ( ColMajor ou RowMajor, cf. Layout.hpp ) :
+ * seules les copies de A et B et l'ajout des tuiles dans C changent, chacune lisant ou écrivant à pas
+ * unitaire dans le rangement reçu. Les huit combinaisons sont instanciées dans Gemm.cpp.
+ */
+template <typename LA, typename LB, typename LC>
+void gemmPacked(int m, int n, int k, const double* A, int ldA, const double* B, int ldB,
+                double* C, int ldC);
+template <typename LA, typename LB, typename LC>
+void gemmPacked(int m, int n, int k, const double* A, int ldA, const double* B, int ldB,
+                double* C, int ldC, const GemmBlocking& blocking);
+
+/**
+ * Forme générale C = alpha * A * B + beta * C : alpha est appliqué lors de la copie des blocs de A, beta lors
+ * de l'ajout des tuiles du premier bloc de k ( C n'est pas lu si beta = 0 ). Aucun passage supplémentaire sur C.
+ */
+template <typename LA, typename LB, typename LC>
+void gemmPacked(int m, int n, int k, double alpha, const double* A, int ldA, const double* B, int ldB,
+                double beta, double* C, int ldC);
+template <typename LA, typename LB, typename LC>
+void gemmPacked(int m, int n, int k, double alpha, const double* A, int ldA, const double* B, int ldB,
+                double beta, double* C, int ldC, const GemmBlocking& blocking);
+template <typename LA, typename LB, typename LC>
+void gemmPacked(int m, int n, int k, float alpha, const float* A, int ldA, const float* B, int ldB,
+                float beta, float* C, int ldC);
+template <typename LA, typename LB, typename LC>
+void gemmPacked(int m, int n, int k, float alpha, const float* A, int ldA, const float* B, int ldB,
+                float beta, float* C, int ldC, const GemmBlocking& blocking);
+
+/**
+ * Précision mixte : A, B et C en float, calcul en double. Les blocs de A et B sont convertis en double lors de
+ * leur copie et passent par le micro-noyau double ; chaque bloc de kc termes est accumulé en double et C n'est
+ * arrondi en float qu'une fois par bloc de k ( au plus k/kc arrondis au lieu de k ). La mémoire lue et écrite
+ * est celle du float, le débit de calcul celui du double.
+ */
+template <typename LA, typename LB, typename LC>
+void gemmPackedMixed(int m, int n, int k, double alpha, const float* A, int ldA, const float* B, int ldB,
+                     double beta, float* C, int ldC);
+template <typename LA, typename LB, typename LC>
+void gemmPackedMixed(int m, int n, int k, double alpha, const float* A, int ldA, const float* B, int ldB,
+                     double beta, float* C, int ldC, const GemmBlocking& blocking);
+
+/**
+ * Même signature que dgemm_ ( BLAS ) : C = alpha * op(A) * op(B) + beta * C, tableaux rangés par colonnes,
+ * op(X) = X si trX vaut 'N', X^T si trX vaut 'T' ( ou 'C' ). op(A) est m x k, op(B) est k x n.
+ */
+void gemm(char trA, char trB, int m, int n, int k, double alpha, const double* A, int ldA,
+          const double* B, int ldB, double beta, double* C, int ldC);
+/// Même chose en simple précision ( sgemm_ )
+void gemm(char trA, char trB, int m, int n, int k, float alpha, const float* A, int ldA,
+          const float* B, int ldB, float beta, float* C, int ldC);
+
+#endif
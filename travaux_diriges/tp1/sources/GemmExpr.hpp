@@ -0,0 +1,214 @@
+#ifndef _GemmExpr_hpp__
+# define _GemmExpr_hpp__
+# include <cassert>
+# include <type_traits>
+# include "Matrix.hpp"
+
+/**
+ * Expressions de produit évaluées paresseusement : A * B, alpha * A * B, alpha * A.t() * B, alpha * A * B + beta * D
+ * ne calculent rien tant qu'elles ne sont pas affectées ( =, +=, -= ) à une matrice ou une vue, puis sont
+ * évaluées en un seul appel à gemmPacked ( alpha dans la copie de A, beta dans le premier ajout à C ), sans
+ * matrice intermédiaire. Les opérandes sont des BasicMatrix<T,L> ou des MatrixView<( const ) T,L>, T valant
+ * double ou float ( les deux opérandes et le résultat de même type ; alpha et beta restent des double ).
+ *
+ * Une expression garde des références sur ses opérandes : ne pas la conserver ( auto E = A*B ) au-delà de
+ * la durée de vie de ceux-ci.
+ */
+
+/// Rangement et type des coefficients d'un opérande matriciel ( pas de type pour les autres types : SFINAE )
+template <typename M> struct matrix_layout {};
+template <typename T, typename L> struct matrix_layout<BasicMatrix<T, L>>
+{
+  using type = L;
+  using value_type = T;
+};
+template <typename T, typename L> struct matrix_layout<MatrixView<T, L>>
+{
+  using type = L;
+  using value_type = typename std::remove_const<T>::type;
+};
+
+template <typename T, typename L> MatrixView<const T, L> asView(const BasicMatrix<T, L>& X) { return X.view(); }
+template <typename T, typename L> MatrixView<const T, L> asView(const MatrixView<const T, L>& X) { return X; }
+template <typename T, typename L> MatrixView<const T, L> asView(const MatrixView<T, L>& X) { return X; }
+
+/// Vrai si les zones mémoire de C et X se recouvrent
+template <typename T, typename LC, typename LX>
+bool storageOverlaps(const MatrixView<T, LC>& C, const MatrixView<const T, LX>& X)
+{
+  if (C.nbRows == 0 || C.nbCols == 0 || X.nbRows == 0 || X.nbCols == 0) return false;
+  const T* cEnd = C.data() + LC::index(C.nbRows - 1, C.nbCols - 1, C.ld()) + 1;
+  const T* xEnd = X.data() + LX::index(X.nbRows - 1, X.nbCols - 1, X.ld()) + 1;
+  return C.data() < xEnd && X.data() < cEnd;
+}
+
+/**
+ * C = alpha * A * B + beta * C ( défini dans ProdMatMat.cpp ). Si C recouvre A ou B, le produit passe par une
+ * matrice temporaire. Sans alpha ni beta et avec un même rangement, l'algorithme choisi par setProdMatMat
+ * ( ou l'autotuner ) est utilisé, sinon gemmPacked ( gemmPackedMixed pour des float en précision mixte ).
+ */
+template <typename T, typename LA, typename LB, typename LC>
+void evalGemm(double alpha, const MatrixView<const T, LA>& A, const MatrixView<const T, LB>& B,
+              double beta, const MatrixView<T, LC>& C);
+
+/// alpha * X
+template <typename T, typename L>
+struct ScaledExpr
+{
+  double alpha;
+  MatrixView<const T, L> X;
+};
+
+/// alpha * A * B
+template <typename T, typename LA, typename LB>
+struct ProductExpr
+{
+  using is_matrix_expr = void;
+
+  ProductExpr(double a, const MatrixView<const T, LA>& A_, const MatrixView<const T, LB>& B_) :
+    alpha{a}, A{A_}, B{B_}, nbRows{A_.nbRows}, nbCols{B_.nbCols}
+  {
+    assert(A_.nbCols == B_.nbRows);
+  }
+
+  template <typename LC> void assignTo(const MatrixView<T, LC>& C) const { evalGemm(alpha, A, B, 0., C); }
+  template <typename LC> void addTo(const MatrixView<T, LC>& C, double sign) const
+  {
+    evalGemm(sign * alpha, A, B, 1., C);
+  }
+
+  double alpha;
+  MatrixView<const T, LA> A;
+  MatrixView<const T, LB> B;
+  int nbRows, nbCols;
+};
+
+/// alpha * A * B + beta * D : un seul appel à gemm si D est la matrice affectée ( C = alpha*A*B + beta*C )
+template <typename T, typename LA, typename LB, typename LD>
+struct GemmExpr
+{
+  using is_matrix_expr = void;
+
+  GemmExpr(const ProductExpr<T, LA, LB>& p, double b, const MatrixView<const T, LD>& D_) :
+    prod{p}, beta{b}, D{D_}, nbRows{p.nbRows}, nbCols{p.nbCols}
+  {
+    assert(D_.nbRows == p.nbRows && D_.nbCols == p.nbCols);
+  }
+
+  template <typename LC> void assignTo(const MatrixView<T, LC>& C) const
+  {
+    if (isTarget(C))
+      evalGemm(prod.alpha, prod.A, prod.B, beta, C);
+    else if (overlaps(C))
+    {
+      BasicMatrix<T, LC> tmp(nbRows, nbCols);
+      assignTo(tmp.view());
+      for (int i = 0; i < nbRows; ++i)
+        for (int j = 0; j < nbCols; ++j) C(i, j) = tmp(i, j);
+    }
+    else
+    {
+      for (int i = 0; i < nbRows; ++i)
+        for (int j = 0; j < nbCols; ++j) C(i, j) = beta * D(i, j);
+      evalGemm(prod.alpha, prod.A, prod.B, 1., C);
+    }
+  }
+
+  template <typename LC> void addTo(const MatrixView<T, LC>& C, double sign) const
+  {
+    if (isTarget(C))
+      evalGemm(sign * prod.alpha, prod.A, prod.B, 1. + sign * beta, C);
+    else
+    {
+      BasicMatrix<T, LC> tmp(nbRows, nbCols);
+      assignTo(tmp.view());
+      for (int i = 0; i < nbRows; ++i)
+        for (int j = 0; j < nbCols; ++j) C(i, j) += sign * tmp(i, j);
+    }
+  }
+
+  ProductExpr<T, LA, LB> prod;
+  double beta;
+  MatrixView<const T, LD> D;
+  int nbRows, nbCols;
+
+private:
+  template <typename LC> bool isTarget(const MatrixView<T, LC>& C) const
+  {
+    return std::is_same<LC, LD>::value && C.data() == D.data() && C.ld() == D.ld();
+  }
+  // C recouvre A, B ou D : écrire beta*D dans C avant le produit en détruirait une partie
+  template <typename LC> bool overlaps(const MatrixView<T, LC>& C) const
+  {
+    return storageOverlaps(C, prod.A) || storageOverlaps(C, prod.B) || storageOverlaps(C, D);
+  }
+};
+
+// ------------------------------------------------------------------------ Opérateurs
+
+template <typename M> using matrix_value_t = typename matrix_layout<M>::value_type;
+
+template <typename MA, typename MB>
+ProductExpr<matrix_value_t<MA>, typename matrix_layout<MA>::type, typename matrix_layout<MB>::type>
+operator* (const MA& A, const MB& B) { return {1., asView(A), asView(B)}; }
+
+template <typename M>
+ScaledExpr<matrix_value_t<M>, typename matrix_layout<M>::type> operator* (double alpha, const M& X)
+{
+  return {alpha, asView(X)};
+}
+template <typename M>
+ScaledExpr<matrix_value_t<M>, typename matrix_layout<M>::type> operator* (const M& X, double alpha)
+{
+  return {alpha, asView(X)};
+}
+
+template <typename T, typename LA, typename MB>
+ProductExpr<T, LA, typename matrix_layout<MB>::type> operator* (const ScaledExpr<T, LA>& A, const MB& B)
+{
+  return {A.alpha, A.X, asView(B)};
+}
+template <typename MA, typename T, typename LB>
+ProductExpr<T, typename matrix_layout<MA>::type, LB> operator* (const MA& A, const ScaledExpr<T, LB>& B)
+{
+  return {B.alpha, asView(A), B.X};
+}
+
+template <typename T, typename LA, typename LB>
+ProductExpr<T, LA, LB> operator* (double alpha, const ProductExpr<T, LA, LB>& P)
+{
+  return {alpha * P.alpha, P.A, P.B};
+}
+template <typename T, typename LA, typename LB>
+ProductExpr<T, LA, LB> operator* (const ProductExpr<T, LA, LB>& P, double alpha)
+{
+  return {alpha * P.alpha, P.A, P.B};
+}
+
+template <typename T, typename LA, typename LB, typename LD>
+GemmExpr<T, LA, LB, LD> operator+ (const ProductExpr<T, LA, LB>& P, const ScaledExpr<T, LD>& D)
+{
+  return {P, D.alpha, D.X};
+}
+template <typename T, typename LA, typename LB, typename LD>
+GemmExpr<T, LA, LB, LD> operator+ (const ScaledExpr<T, LD>& D, const ProductExpr<T, LA, LB>& P)
+{
+  return {P, D.alpha, D.X};
+}
+template <typename T, typename LA, typename LB, typename LD>
+GemmExpr<T, LA, LB, LD> operator- (const ProductExpr<T, LA, LB>& P, const ScaledExpr<T, LD>& D)
+{
+  return {P, -D.alpha, D.X};
+}
+template <typename T, typename LA, typename LB, typename MD>
+GemmExpr<T, LA, LB, typename matrix_layout<MD>::type> operator+ (const ProductExpr<T, LA, LB>& P, const MD& D)
+{
+  return {P, 1., asView(D)};
+}
+template <typename T, typename LA, typename LB, typename MD>
+GemmExpr<T, LA, LB, typename matrix_layout<MD>::type> operator- (const ProductExpr<T, LA, LB>& P, const MD& D)
+{
+  return {P, -1., asView(D)};
+}
+
+#endif
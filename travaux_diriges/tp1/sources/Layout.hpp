@@ -0,0 +1,29 @@
+#ifndef _LAYOUT_HPP_
+# define _LAYOUT_HPP_
+# include <cstddef>
+
+/**
+ * Rangement en mémoire d'une matrice de leading dimension ld :
+ *   ColMajor : X(i,j) = X[i + j*ld], ld >= nbRows ( rangement Fortran/BLAS )
+ *   RowMajor : X(i,j) = X[i*ld + j], ld >= nbCols ( rangement C )
+ * Transpose<L> est le rangement de la transposée lue dans le même tableau.
+ */
+struct ColMajor
+{
+  static constexpr bool isColMajor = true;
+  static std::size_t index(int i, int j, int ld) { return std::size_t(i) + std::size_t(j) * ld; }
+  static int defaultLd(int nRows, int /*nCols*/) { return nRows; }
+};
+
+struct RowMajor
+{
+  static constexpr bool isColMajor = false;
+  static std::size_t index(int i, int j, int ld) { return std::size_t(i) * ld + std::size_t(j); }
+  static int defaultLd(int /*nRows*/, int nCols) { return nCols; }
+};
+
+template <typename L> struct Transpose;
+template <> struct Transpose<ColMajor> { using type = RowMajor; };
+template <> struct Transpose<RowMajor> { using type = ColMajor; };
+
+#endif
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "MatVec.hpp"
+
+namespace {
+// En dessous, lancer les threads coûte plus cher que le produit
+constexpr double parallel_threshold = 1 << 15;
+constexpr int line = 8;  // doubles par ligne de cache
+
+// Tranche de lignes [i0, i1) du thread courant. Les bornes intérieures sont placées sur des débuts de lignes de
+// cache de y, d'après son adresse ( y n'a pas à être aligné ) : deux threads n'écrivent jamais dans la même ligne
+// de y
+void threadRows(int m, const double* y, int& i0, int& i1) {
+#if defined(_OPENMP)
+  const int nt = omp_get_num_threads(), t = omp_get_thread_num();
+#else
+  const int nt = 1, t = 0;
+#endif
+  // y[head] est le premier coefficient de y en début de ligne de cache
+  const int head = int((line - reinterpret_cast<std::uintptr_t>(y) / sizeof(double) % line) % line);
+  const int nbLines = (std::max(m - head, 0) + line - 1) / line;
+  auto bound = [&](int r) { return r == 0 ? 0 : std::min(m, head + (nbLines * r / nt) * line); };
+  i0 = bound(t);
+  i1 = bound(t + 1);
+}
+
+// y(i0:i1) = alpha * A(i0:i1,:) * x + beta * y(i0:i1), A rangée par colonnes
+void gemvColRange(int i0, int i1, int n, double alpha, const double* A, int ldA, const double* x, double beta,
+                  double* y) {
+  if (beta == 0.)
+    std::fill(y + i0, y + i1, 0.);
+  else if (beta != 1.)
+    for (int i = i0; i < i1; ++i) y[i] *= beta;
+  int j = 0;
+  for (; j + 4 <= n; j += 4) {
+    const double x0 = alpha * x[j], x1 = alpha * x[j + 1], x2 = alpha * x[j + 2], x3 = alpha * x[j + 3];
+    const double* a0 = A + std::size_t(j) * ldA;
+    const double* a1 = a0 + ldA;
+    const double* a2 = a1 + ldA;
+    const double* a3 = a2 + ldA;
+#if defined(_OPENMP)
+    #pragma omp simd
+#endif
+    for (int i = i0; i < i1; ++i) y[i] += a0[i] * x0 + a1[i] * x1 + a2[i] * x2 + a3[i] * x3;
+  }
+  for (; j < n; ++j) {
+    const double xj = alpha * x[j];
+    const double* a = A + std::size_t(j) * ldA;
+#if defined(_OPENMP)
+    #pragma omp simd
+#endif
+    for (int i = i0; i < i1; ++i) y[i] += a[i] * xj;
+  }
+}
+
+// y(i0:i1) = alpha * A(i0:i1,:) * x + beta * y(i0:i1), A rangée par lignes
+void gemvRowRange(int i0, int i1, int n, double alpha, const double* A, int ldA, const double* x, double beta,
+                  double* y) {
+  auto update = [&](int i, double s) { y[i] = (beta == 0. ? alpha * s : alpha * s + beta * y[i]); };
+  int i = i0;
+  for (; i + 4 <= i1; i += 4) {
+    const double* a0 = A + std::size_t(i) * ldA;
+    const double* a1 = a0 + ldA;
+    const double* a2 = a1 + ldA;
+    const double* a3 = a2 + ldA;
+    double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+#if defined(_OPENMP)
+    #pragma omp simd reduction(+ : s0, s1, s2, s3)
+#endif
+    for (int j = 0; j < n; ++j) {
+      s0 += a0[j] * x[j];
+      s1 += a1[j] * x[j];
+      s2 += a2[j] * x[j];
+      s3 += a3[j] * x[j];
+    }
+    update(i, s0);
+    update(i + 1, s1);
+    update(i + 2, s2);
+    update(i + 3, s3);
+  }
+  for (; i < i1; ++i) {
+    const double* a = A + std::size_t(i) * ldA;
+    double s = 0.;
+#if defined(_OPENMP)
+    #pragma omp simd reduction(+ : s)
+#endif
+    for (int j = 0; j < n; ++j) s += a[j] * x[j];
+    update(i, s);
+  }
+}
+}  // namespace
+
+template <typename L>
+void gemv(double alpha, const MatrixView<const double, L>& A, const double* x, double beta, double* y) {
+  const int m = A.nbRows, n = A.nbCols;
+  const bool parallel = double(m) * n >= parallel_threshold;
+#if defined(_OPENMP)
+  #pragma omp parallel if (parallel)
+#endif
+  {
+    int i0, i1;
+    threadRows(m, y, i0, i1);
+    if (L::isColMajor)
+      gemvColRange(i0, i1, n, alpha, A.data(), A.ld(), x, beta, y);
+    else
+      gemvRowRange(i0, i1, n, alpha, A.data(), A.ld(), x, beta, y);
+  }
+  (void)parallel;
+}
+
+template <typename L>
+std::vector<double> operator* (const BasicMatrix<double, L>& A, const std::vector<double>& x) {
+  assert(int(x.size()) == A.nbCols);
+  std::vector<double> y(A.nbRows);
+  gemv(1., A.view(), x.data(), 0., y.data());
+  return y;
+}
+
+template void gemv<ColMajor>(double, const MatrixView<const double, ColMajor>&, const double*, double, double*);
+template void gemv<RowMajor>(double, const MatrixView<const double, RowMajor>&, const double*, double, double*);
+template std::vector<double> operator* (const Matrix&, const std::vector<double>&);
+template std::vector<double> operator* (const RowMatrix&, const std::vector<double>&);
@@ -0,0 +1,24 @@
+#ifndef _MatVec_hpp__
+# define _MatVec_hpp__
+# include <vector>
+# include "Matrix.hpp"
+
+/**
+ * Produit matrice-vecteur y = alpha * A * x + beta * y ( y n'est pas lu si beta = 0 ).
+ *
+ * Chaque coefficient de A n'est lu qu'une fois pour 2 flops : le produit est limité par la bande passante
+ * mémoire, et les noyaux cherchent seulement à lire A une seule fois, à pas unitaire, avec tous les cœurs :
+ *   ColMajor : y += A(:,j) * x(j) par groupes de 4 colonnes ( y relu 4 fois moins souvent ), chaque thread
+ *              traitant une tranche de lignes ( alignée sur les lignes de cache ) pour toutes les colonnes ;
+ *   RowMajor : produits scalaires de 4 lignes à la fois avec x ( x relu 4 fois moins souvent ), les lignes
+ *              étant réparties entre threads.
+ * Les boucles internes sont vectorisées ( omp simd ). Les petites matrices restent séquentielles.
+ */
+template <typename L>
+void gemv(double alpha, const MatrixView<const double, L>& A, const double* x, double beta, double* y);
+
+/// y = A * x
+template <typename L>
+std::vector<double> operator* (const BasicMatrix<double, L>& A, const std::vector<double>& x);
+
+#endif
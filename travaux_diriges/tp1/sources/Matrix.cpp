@@ -1,11 +1,55 @@
 # include "Matrix.hpp"
 # include <cassert>
 
-Matrix::Matrix( int nRows, int nCols ) :
-  nbRows{nRows}, nbCols{nCols}, m_arr_coefs(nRows*nCols)
-{}
+namespace
+{
+  // En dessous, lancer les threads coûte plus cher que l'initialisation elle-même
+  constexpr std::size_t first_touch_threshold = 1 << 16;
+}
+
+template <typename T, typename Layout>
+int BasicMatrix<T, Layout>::paddedLd( int n )
+{
+  constexpr int line = int(64 / sizeof(T));      // coefficients par ligne de cache
+  constexpr int critical = int(512 / sizeof(T)); // pas critique : 512 octets
+  int ld = (n + line - 1) / line * line;
+  if ( ld >= critical && ld % critical == 0 ) ld += line;
+  return ld;
+}
 // ------------------------------------------------------------------------
-Matrix::Matrix( int nRows, int nCols, double val ) :
-  nbRows{nRows}, nbCols{nCols}, m_arr_coefs(nRows*nCols, val)
+template <typename T, typename Layout>
+BasicMatrix<T, Layout>::BasicMatrix( int nRows, int nCols ) :
+  BasicMatrix( nRows, nCols, T(0) )
 {}
+// ------------------------------------------------------------------------
+template <typename T, typename Layout>
+BasicMatrix<T, Layout>::BasicMatrix( int nRows, int nCols, T val ) :
+  nbRows{nRows}, nbCols{nCols}, m_ld{paddedLd(Layout::defaultLd(nRows, nCols))},
+  m_arr_coefs(std::size_t(m_ld) * (Layout::isColMajor ? nCols : nRows))
+{
+  firstTouch( val );
+}
+// ------------------------------------------------------------------------
+// Première écriture de chaque colonne ( ligne en RowMajor ) par le thread qui la traitera avec un
+// partage statique, comme dans les produits parallèles
+template <typename T, typename Layout>
+void BasicMatrix<T, Layout>::firstTouch( T val )
+{
+  const int nOuter = Layout::isColMajor ? nbCols : nbRows;
+  const int nInner = Layout::isColMajor ? nbRows : nbCols;
+  T* coefs = m_arr_coefs.data();
+  const int ld = m_ld;
+#if defined(_OPENMP)
+# pragma omp parallel for schedule(static) if (m_arr_coefs.size() >= first_touch_threshold)
+#endif
+  for ( int o = 0; o < nOuter; ++o ) {
+    T* col = coefs + std::size_t(o) * ld;
+    for ( int i = 0; i < nInner; ++i ) col[i] = val;
+    for ( int i = nInner; i < ld; ++i ) col[i] = T(0);
+  }
+}
 // ========================================================================
+template class BasicMatrix<double, ColMajor>;
+template class BasicMatrix<double, RowMajor>;
+template class BasicMatrix<float, ColMajor>;
+template class BasicMatrix<float, RowMajor>;
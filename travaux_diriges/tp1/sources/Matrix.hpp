@@ -1,39 +1,182 @@
 #ifndef _MATRIX_HPP_
 # define _MATRIX_HPP_
 
+# include <cstddef>
+# include <cstdlib>
+# include <new>
+# include <utility>
 # include <vector>
+# include "Layout.hpp"
 
-class Matrix
+/**
+ * Allocateur aligné sur Align octets ( une ligne de cache par défaut ). construct() sans argument laisse la
+ * valeur non initialisée : la première écriture est faite par le constructeur de la matrice, en parallèle,
+ * pour que chaque page soit placée sur le noeud NUMA du thread qui la calculera ( "first touch" ).
+ */
+template <typename T, std::size_t Align = 64>
+struct AlignedAllocator
+{
+  using value_type = T;
+  template <typename U> struct rebind { using other = AlignedAllocator<U, Align>; };
+
+  AlignedAllocator() = default;
+  template <typename U> AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+  T* allocate(std::size_t n)
+  {
+    void* p = nullptr;
+    if (posix_memalign(&p, Align, (n > 0 ? n : 1) * sizeof(T)) != 0) throw std::bad_alloc();
+    return static_cast<T*>(p);
+  }
+  void deallocate(T* p, std::size_t) { std::free(p); }
+
+  template <typename U> void construct(U* p) { ::new (static_cast<void*>(p)) U; }
+  template <typename U, typename... Args> void construct(U* p, Args&&... args)
+  {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+
+  template <typename U> bool operator==(const AlignedAllocator<U, Align>&) const { return true; }
+  template <typename U> bool operator!=(const AlignedAllocator<U, Align>&) const { return false; }
+};
+
+/**
+ * Vue ( sans copie ) sur une matrice ou une sous-matrice : pointeur sur le premier coefficient,
+ * dimensions et leading dimension. T peut être const pour une vue en lecture seule.
+ */
+template <typename T, typename Layout = ColMajor>
+class MatrixView
+{
+public:
+  using value_type = T;
+  using layout = Layout;
+
+  MatrixView(T* ptr, int nRows, int nCols, int ld) :
+    nbRows{nRows}, nbCols{nCols}, m_ld{ld}, m_ptr{ptr}
+  {}
+  // Une vue modifiable se convertit en vue en lecture seule
+  template <typename U>
+  MatrixView(const MatrixView<U, Layout>& V) :
+    nbRows{V.nbRows}, nbCols{V.nbCols}, m_ld{V.ld()}, m_ptr{V.data()}
+  {}
+
+  T& operator() (int i, int j) const
+  {
+    return m_ptr[Layout::index(i, j, m_ld)];
+  }
+
+  /// Sous-matrice de taille nRows x nCols commençant en (i0,j0)
+  MatrixView view(int i0, int j0, int nRows, int nCols) const
+  {
+    return MatrixView(m_ptr + Layout::index(i0, j0, m_ld), nRows, nCols, m_ld);
+  }
+
+  /// Transposée, sans copie : même tableau lu dans l'autre rangement
+  MatrixView<T, typename Transpose<Layout>::type> t() const { return {m_ptr, nbCols, nbRows, m_ld}; }
+
+  /// Accumulation d'une expression ( cf. GemmExpr.hpp ) dans la sous-matrice
+  template <typename E, typename = typename E::is_matrix_expr>
+  const MatrixView& operator+=(const E& e) const { e.addTo(*this, 1.); return *this; }
+  template <typename E, typename = typename E::is_matrix_expr>
+  const MatrixView& operator-=(const E& e) const { e.addTo(*this, -1.); return *this; }
+
+  T* data() const { return m_ptr; }
+  int ld() const { return m_ld; }
+
+  int nbRows, nbCols;
+private:
+  int m_ld;
+  T* m_ptr;
+};
+
+/**
+ * Matrice dense stockée dans un tableau aligné sur 64 octets. La leading dimension est complétée
+ * ( paddedLd ) pour que chaque colonne ( ou ligne en RowMajor ) commence sur une ligne de cache et que le
+ * pas entre colonnes ne soit pas un multiple de 512 octets : avec n = 1024 ou 2048, les colonnes
+ * successives tomberaient sinon dans les mêmes ensembles des caches associatifs. Les coefficients de
+ * remplissage valent 0 et ne sont jamais lus par operator().
+ */
+template <typename T, typename Layout = ColMajor>
+class BasicMatrix
 {
 public:
+  using value_type = T;
+  using layout = Layout;
+
   // Constructors - destructor
-  Matrix(int nRows, int nCols);
-  Matrix(int nRows, int nCols, double val);
-  Matrix(const Matrix & A) = delete;
-  Matrix(Matrix && A) = default;
-  ~Matrix() = default;
+  BasicMatrix(int nRows, int nCols);
+  BasicMatrix(int nRows, int nCols, T val);
+  BasicMatrix(const BasicMatrix & A) = delete;
+  BasicMatrix(BasicMatrix && A) = default;
+  /// Évaluation d'une expression ( cf. GemmExpr.hpp ), par exemple Matrix C = A * B;
+  template <typename E, typename = typename E::is_matrix_expr>
+  BasicMatrix(const E& e) : BasicMatrix(e.nbRows, e.nbCols) { e.assignTo(view()); }
+  ~BasicMatrix() = default;
 
   // Operators
-  Matrix & operator =(const Matrix & A) = delete;
-  Matrix & operator =(Matrix && A) = default;
+  BasicMatrix & operator =(const BasicMatrix & A) = delete;
+  BasicMatrix & operator =(BasicMatrix && A) = default;
+  template <typename E, typename = typename E::is_matrix_expr>
+  BasicMatrix & operator =(const E& e)
+  {
+    // L'expression peut lire *this ( C = C * D ) : si la forme change, elle est évaluée dans une nouvelle
+    // matrice avant que l'ancien stockage ne soit libéré
+    if (e.nbRows != nbRows || e.nbCols != nbCols)
+      *this = BasicMatrix(e);
+    else
+      e.assignTo(view());
+    return *this;
+  }
+  template <typename E, typename = typename E::is_matrix_expr>
+  BasicMatrix & operator +=(const E& e) { e.addTo(view(), 1.); return *this; }
+  template <typename E, typename = typename E::is_matrix_expr>
+  BasicMatrix & operator -=(const E& e) { e.addTo(view(), -1.); return *this; }
 
-  // Getters - Setters 
-  double operator() (int i, int j) const
+  // Getters - Setters
+  T operator() (int i, int j) const
   {
-    return m_arr_coefs[i+j*nbRows];
+    return m_arr_coefs[Layout::index(i, j, m_ld)];
   }
 
-  double &operator() (int i, int j)
+  T &operator() (int i, int j)
+  {
+    return m_arr_coefs[Layout::index(i, j, m_ld)];
+  }
+
+  T const* data() const { return m_arr_coefs.data(); }
+  T      * data()       { return m_arr_coefs.data(); }
+  int ld() const { return m_ld; }
+
+  /// Leading dimension utilisée pour une colonne ( ou ligne ) de n coefficients
+  static int paddedLd(int n);
+
+  /// Transposée, sans copie ( vue en lecture seule )
+  MatrixView<const T, typename Transpose<Layout>::type> t() const { return view().t(); }
+
+  MatrixView<T, Layout> view() { return {data(), nbRows, nbCols, m_ld}; }
+  MatrixView<const T, Layout> view() const { return {data(), nbRows, nbCols, m_ld}; }
+  MatrixView<T, Layout> view(int i0, int j0, int nRows, int nCols) { return view().view(i0, j0, nRows, nCols); }
+  MatrixView<const T, Layout> view(int i0, int j0, int nRows, int nCols) const
   {
-    return m_arr_coefs[i+j*nbRows];
+    return view().view(i0, j0, nRows, nCols);
   }
 
-  double const* data() const { return m_arr_coefs.data(); }
-  double      * data()       { return m_arr_coefs.data(); }
-  
   int nbRows, nbCols;
 private:
-  std::vector < double >m_arr_coefs;
+  int m_ld;
+  void firstTouch(T val);
+
+  std::vector < T, AlignedAllocator<T> >m_arr_coefs;
 };
 
+using Matrix = BasicMatrix<double, ColMajor>;
+using RowMatrix = BasicMatrix<double, RowMajor>;
+using FloatMatrix = BasicMatrix<float, ColMajor>;
+using FloatRowMatrix = BasicMatrix<float, RowMajor>;
+
+extern template class BasicMatrix<double, ColMajor>;
+extern template class BasicMatrix<double, RowMajor>;
+extern template class BasicMatrix<float, ColMajor>;
+extern template class BasicMatrix<float, RowMajor>;
+
 #endif
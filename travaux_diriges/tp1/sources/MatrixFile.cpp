@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MatrixFile.hpp"
+#include "Gemm.hpp"
+
+namespace {
+constexpr char magic[8] = {'O', 'S', '2', '0', '2', 'M', 'A', 'T'};
+constexpr std::uint32_t version = 1;
+constexpr std::int64_t headerSize = 4096;  // une page : les tuiles restent alignées sur les pages
+
+[[noreturn]] void throwErrno(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+std::size_t pageSize() {
+  static const std::size_t sz = std::size_t(sysconf(_SC_PAGESIZE));
+  return sz;
+}
+
+// Dimensions représentables ( int ) et taille du fichier représentable ( off_t ), tuiles non vides : vérifié
+// avant tout calcul, en particulier pour un en-tête lu dans un fichier corrompu
+bool validDimensions(std::int64_t nRows, std::int64_t nCols, std::int64_t tRows, std::int64_t tCols) {
+  constexpr std::int64_t intMax = std::numeric_limits<int>::max();
+  if (nRows < 0 || nCols < 0 || tRows <= 0 || tCols <= 0) return false;
+  if (nRows > intMax || nCols > intMax || tRows > intMax || tCols > intMax) return false;
+  if (nRows + tRows - 1 > intMax || nCols + tCols - 1 > intMax) return false;  // nbTileRows(), nbTileCols()
+  const long double bytes = (long double)headerSize + (long double)((nRows + tRows - 1) / tRows) *
+                            ((nCols + tCols - 1) / tCols) * tRows * tCols * sizeof(double);
+  return bytes <= (long double)std::numeric_limits<off_t>::max() &&
+         bytes <= (long double)std::numeric_limits<std::size_t>::max();
+}
+
+// Zone [p, p+len) élargie aux pages qui la contiennent ( madvise et msync veulent une adresse alignée )
+void pageRange(const void* p, std::size_t len, void*& start, std::size_t& size) {
+  const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(p) / pageSize() * pageSize();
+  const std::uintptr_t last = reinterpret_cast<std::uintptr_t>(p) + len;
+  start = reinterpret_cast<void*>(first);
+  size = last - first;
+}
+}  // namespace
+
+MatrixFile::MatrixFile(const std::string& path, int nRows, int nCols, int tRows, int tCols) :
+  nbRows{nRows}, nbCols{nCols}, tileRows{tRows}, tileCols{tCols}, writable{true}
+{
+  if (!validDimensions(nRows, nCols, tRows, tCols))
+    throw std::invalid_argument("MatrixFile : dimensions invalides");
+  m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (m_fd < 0) throwErrno("MatrixFile : création de " + path);
+  MatrixFileHeader header{};
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.elemSize = sizeof(double);
+  header.nbRows = nRows;
+  header.nbCols = nCols;
+  header.tileRows = tRows;
+  header.tileCols = tCols;
+  header.dataOffset = headerSize;
+  // Le fichier est creux : les tuiles valent 0 sans avoir été écrites
+  const off_t fileSize = off_t(headerSize + std::int64_t(nbTileRows()) * nbTileCols() * tileBytes());
+  if (::ftruncate(m_fd, fileSize) != 0 || ::pwrite(m_fd, &header, sizeof(header), 0) != sizeof(header)) {
+    ::close(m_fd);
+    throwErrno("MatrixFile : écriture de " + path);
+  }
+  map(path);
+}
+
+MatrixFile::MatrixFile(const std::string& path, bool canWrite) : writable{canWrite}
+{
+  m_fd = ::open(path.c_str(), canWrite ? O_RDWR : O_RDONLY);
+  if (m_fd < 0) throwErrno("MatrixFile : ouverture de " + path);
+  MatrixFileHeader header;
+  if (::pread(m_fd, &header, sizeof(header), 0) != sizeof(header) ||
+      std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version ||
+      header.elemSize != sizeof(double) || header.dataOffset != headerSize ||
+      !validDimensions(header.nbRows, header.nbCols, header.tileRows, header.tileCols)) {
+    ::close(m_fd);
+    throw std::runtime_error("MatrixFile : " + path + " n'est pas un fichier de matrice valide");
+  }
+  nbRows = int(header.nbRows);
+  nbCols = int(header.nbCols);
+  tileRows = int(header.tileRows);
+  tileCols = int(header.tileCols);
+  map(path);
+}
+
+void MatrixFile::map(const std::string& path)
+{
+  m_mapSize = std::size_t(headerSize) + std::size_t(nbTileRows()) * nbTileCols() * tileBytes();
+  struct stat st;
+  if (::fstat(m_fd, &st) != 0 || std::size_t(st.st_size) < m_mapSize) {
+    ::close(m_fd);
+    throw std::runtime_error("MatrixFile : " + path + " est tronqué");
+  }
+  m_map = ::mmap(nullptr, m_mapSize, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, m_fd, 0);
+  if (m_map == MAP_FAILED) {
+    ::close(m_fd);
+    throwErrno("MatrixFile : mmap de " + path);
+  }
+  m_data = reinterpret_cast<double*>(static_cast<char*>(m_map) + headerSize);
+}
+
+MatrixFile::~MatrixFile()
+{
+  ::munmap(m_map, m_mapSize);
+  ::close(m_fd);
+}
+
+void MatrixFile::adviseWillNeed(int I, int J) const
+{
+  void* start;
+  std::size_t size;
+  pageRange(tile(I, J), tileBytes(), start, size);
+  ::madvise(start, size, MADV_WILLNEED);
+}
+
+void MatrixFile::writeBack(int I, int J) const
+{
+  if (!writable) return;
+  void* start;
+  std::size_t size;
+  pageRange(tile(I, J), tileBytes(), start, size);
+  ::msync(start, size, MS_ASYNC);
+}
+
+void MatrixFile::flush() const
+{
+  if (writable && ::msync(m_map, m_mapSize, MS_SYNC) != 0) throwErrno("MatrixFile : msync");
+}
+
+// ========================================================================
+namespace {
+// Une étape du produit : C(I,J) += A(I,P) * B(P,J)
+struct Step {
+  int I, J, P;
+};
+
+/**
+ * Thread d'E/S : charge les tuiles des étapes à l'avance, au plus depth étapes devant le calcul. madvise
+ * lance la lecture de toute la tuile d'un coup, la lecture d'un double par page attend qu'elle soit en mémoire :
+ * le thread de calcul ne subit alors plus de défaut de page sur disque.
+ */
+class TilePrefetcher {
+public:
+  TilePrefetcher(const MatrixFile& A, const MatrixFile& B, const MatrixFile& C, const std::vector<Step>& steps,
+                 int depth) :
+    m_A(A), m_B(B), m_C(C), m_steps(steps), m_depth(std::max(1, depth)), m_thread([this] { run(); })
+  {}
+  ~TilePrefetcher() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+
+  /// Attend que les tuiles de l'étape s soient chargées
+  void waitLoaded(std::size_t s) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [&] { return m_loaded > s; });
+  }
+  /// L'étape s est calculée : le thread d'E/S peut avancer
+  void computed(std::size_t s) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_computed = s + 1;
+    }
+    m_cond.notify_all();
+  }
+
+private:
+  static double touch(const MatrixFile& M, int I, int J) {
+    M.adviseWillNeed(I, J);
+    const double* p = M.tile(I, J);
+    const std::size_t stride = pageSize() / sizeof(double), n = M.tileBytes() / sizeof(double);
+    double sum = 0.;
+    for (std::size_t i = 0; i < n; i += stride) sum += *static_cast<const volatile double*>(p + i);
+    return sum;
+  }
+
+  void run() {
+    double sink = 0.;
+    for (std::size_t s = 0; s < m_steps.size(); ++s) {
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [&] { return m_stop || s < m_computed + m_depth; });
+        if (m_stop) return;
+      }
+      const Step& st = m_steps[s];
+      sink += touch(m_A, st.I, st.P) + touch(m_B, st.P, st.J);
+      if (s == 0 || st.I != m_steps[s - 1].I || st.J != m_steps[s - 1].J) sink += touch(m_C, st.I, st.J);
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_loaded = s + 1;
+      }
+      m_cond.notify_all();
+    }
+    m_sink = sink;
+  }
+
+  const MatrixFile &m_A, &m_B, &m_C;
+  const std::vector<Step>& m_steps;
+  const std::size_t m_depth;
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::size_t m_loaded = 0, m_computed = 0;
+  bool m_stop = false;
+  double m_sink = 0.;  // empêche le compilateur de supprimer les lectures
+  std::thread m_thread;
+};
+}  // namespace
+
+OutOfCoreStats gemmOutOfCore(const MatrixFile& A, const MatrixFile& B, MatrixFile& C, int prefetchDepth)
+{
+  if (A.nbCols != B.nbRows || C.nbRows != A.nbRows || C.nbCols != B.nbCols)
+    throw std::invalid_argument("gemmOutOfCore : dimensions incompatibles");
+  if (A.tileCols != B.tileRows || C.tileRows != A.tileRows || C.tileCols != B.tileCols)
+    throw std::invalid_argument("gemmOutOfCore : tuiles incompatibles");
+  if (!C.writable) throw std::invalid_argument("gemmOutOfCore : C est ouverte en lecture seule");
+
+  // J, I puis P : chaque tuile de C est terminée avant de passer à la suivante, la bande de colonnes de B
+  // ( J fixé ) est relue depuis le cache du système pour chaque I
+  std::vector<Step> steps;
+  const int nbK = (A.nbCols == 0 ? 0 : A.nbTileCols());
+  for (int J = 0; J < C.nbTileCols(); ++J)
+    for (int I = 0; I < C.nbTileRows(); ++I)
+      for (int P = 0; P < nbK; ++P) steps.push_back({I, J, P});
+
+  OutOfCoreStats stats{0., 0.};
+  TilePrefetcher prefetcher(A, B, C, steps, prefetchDepth);
+  using clock = std::chrono::steady_clock;
+  for (std::size_t s = 0; s < steps.size(); ++s) {
+    const Step& st = steps[s];
+    auto t0 = clock::now();
+    prefetcher.waitLoaded(s);
+    auto t1 = clock::now();
+    gemmPacked(A.tileHeight(st.I), B.tileWidth(st.J), A.tileWidth(st.P), A.tile(st.I, st.P), A.tileRows,
+               B.tile(st.P, st.J), B.tileRows, C.tile(st.I, st.J), C.tileRows);
+    auto t2 = clock::now();
+    prefetcher.computed(s);
+    if (st.P + 1 == nbK) C.writeBack(st.I, st.J);
+    stats.ioWaitTime += std::chrono::duration<double>(t1 - t0).count();
+    stats.computeTime += std::chrono::duration<double>(t2 - t1).count();
+  }
+  return stats;
+}
@@ -0,0 +1,94 @@
+#ifndef _MatrixFile_hpp__
+# define _MatrixFile_hpp__
+# include <cstddef>
+# include <cstdint>
+# include <string>
+
+/**
+ * Matrice de doubles stockée dans un fichier et projetée en mémoire ( mmap ) : seules les pages touchées
+ * sont chargées, le système relit ou réécrit le reste à la demande. Le fichier contient un en-tête d'une page
+ * puis les tuiles tileRows x tileCols, chacune rangée par colonnes ( ld = tileRows ) et complétée par des
+ * zéros au bord de la matrice, les tuiles étant elles-mêmes rangées par colonnes de tuiles :
+ *
+ *     tuile (I,J) à l'octet dataOffset + (I + J*nbTileRows()) * tileRows*tileCols*sizeof(double)
+ *
+ * Une tuile est donc une zone contiguë du fichier : la lire est une seule lecture séquentielle.
+ * Les erreurs système ( ouverture, mmap, format ) lèvent std::system_error ou std::runtime_error.
+ */
+struct MatrixFileHeader
+{
+  char          magic[8];  // "OS202MAT"
+  std::uint32_t version, elemSize;
+  std::int64_t  nbRows, nbCols, tileRows, tileCols;
+  std::int64_t  dataOffset;
+};
+
+class MatrixFile
+{
+public:
+  /// Crée ( ou écrase ) le fichier d'une matrice nulle nRows x nCols, ouvert en lecture-écriture
+  MatrixFile(const std::string& path, int nRows, int nCols, int tileRows, int tileCols);
+  /// Ouvre un fichier existant
+  explicit MatrixFile(const std::string& path, bool writable = false);
+  MatrixFile(const MatrixFile&) = delete;
+  MatrixFile& operator=(const MatrixFile&) = delete;
+  ~MatrixFile();
+
+  int nbTileRows() const { return (nbRows + tileRows - 1) / tileRows; }
+  int nbTileCols() const { return (nbCols + tileCols - 1) / tileCols; }
+  /// Dimensions utiles de la tuile (I,J) ( plus petites que tileRows x tileCols au bord )
+  int tileHeight(int I) const { return (I + 1 < nbTileRows() ? tileRows : nbRows - I * tileRows); }
+  int tileWidth(int J) const { return (J + 1 < nbTileCols() ? tileCols : nbCols - J * tileCols); }
+  std::size_t tileBytes() const { return std::size_t(tileRows) * tileCols * sizeof(double); }
+
+  /// Tuile (I,J) : T(i,j) = tile(I,J)[i + j*tileRows]
+  double* tile(int I, int J) { return m_data + (I + std::size_t(J) * nbTileRows()) * tileRows * tileCols; }
+  const double* tile(int I, int J) const
+  {
+    return m_data + (I + std::size_t(J) * nbTileRows()) * tileRows * tileCols;
+  }
+
+  double operator() (int i, int j) const
+  {
+    return tile(i / tileRows, j / tileCols)[i % tileRows + std::size_t(j % tileCols) * tileRows];
+  }
+  double& operator() (int i, int j)
+  {
+    return tile(i / tileRows, j / tileCols)[i % tileRows + std::size_t(j % tileCols) * tileRows];
+  }
+
+  /// Demande au système de charger la tuile (I,J) en avance ( non bloquant )
+  void adviseWillNeed(int I, int J) const;
+  /// Lance l'écriture sur disque de la tuile (I,J) ( non bloquant ) ; flush() attend toutes les écritures
+  void writeBack(int I, int J) const;
+  void flush() const;
+
+  int nbRows, nbCols;      // dimensions de la matrice
+  int tileRows, tileCols;  // dimensions des tuiles
+  bool writable;
+private:
+  void map(const std::string& path);
+
+  int m_fd = -1;
+  std::size_t m_mapSize = 0;
+  void* m_map = nullptr;
+  double* m_data = nullptr;
+};
+
+/// Temps passé par gemmOutOfCore à calculer et à attendre les tuiles ( secondes )
+struct OutOfCoreStats
+{
+  double computeTime, ioWaitTime;
+};
+
+/**
+ * C += A * B sur des matrices stockées dans des fichiers, tuile par tuile : pour chaque tuile (I,J) de C et
+ * chaque P, C(I,J) += A(I,P) * B(P,J) avec gemmPacked ( parallélisé avec OpenMP ). Un thread d'E/S charge les
+ * tuiles des prefetchDepth étapes suivantes pendant le calcul de l'étape courante, et l'écriture de chaque
+ * tuile de C terminée est lancée aussitôt. Une étape lit 2 tuiles de t x t doubles ( 16 t^2 octets ) pour
+ * 2 t^3 flops : avec t = 2048, 256 flops par octet lu suffisent à rester limité par le calcul, même sur disque.
+ * Il faut A.tileCols == B.tileRows, C.tileRows == A.tileRows et C.tileCols == B.tileCols.
+ */
+OutOfCoreStats gemmOutOfCore(const MatrixFile& A, const MatrixFile& B, MatrixFile& C, int prefetchDepth = 2);
+
+#endif
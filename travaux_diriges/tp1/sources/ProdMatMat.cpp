@@ -1,50 +1,374 @@
 #include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <utility>
+#include <unistd.h>
 #if defined(_OPENMP)
 #include <omp.h>
 #endif
 #include "ProdMatMat.hpp"
+#include "Gemm.hpp"
+#include "Strassen.hpp"
 
 namespace {
 int g_block_size = 32;
+prod_algo g_algo = automatic;
+bool g_algo_set = false;  // setProdMatMat() prime sur PROD_ALGO / BLOCK_SIZE
+bool g_mixed = false;     // produits float accumulés en double
+std::once_flag g_env_once;
 
-int getBlockSize() {
-  const char* env = std::getenv("BLOCK_SIZE");
-  if (env && *env) {
-    int val = std::atoi(env);
-    if (val > 0)
-      return val;
+const char* const g_algo_names[] = {"naive", "block", "parallel_naive", "parallel_block1",
+                                    "parallel_block2", "parallel_tasks", "packed", "strassen", "automatic"};
+
+// Les variables d'environnement ne sont lues qu'une fois, au premier produit
+void readEnvironment() {
+  std::call_once(g_env_once, [] {
+    const char* env = std::getenv("BLOCK_SIZE");
+    bool hasBlockSize = false;
+    if (env && *env) {
+      int val = std::atoi(env);
+      if (val > 0) {
+        g_block_size = val;
+        hasBlockSize = true;
+      }
+    }
+    const char* mixed = std::getenv("PROD_MIXED");
+    if (mixed && *mixed) g_mixed = (std::atoi(mixed) != 0);
+    if (g_algo_set) return;
+    const char* name = std::getenv("PROD_ALGO");
+    if (name && *name) {
+      for (int a = naive; a <= automatic; ++a)
+        if (std::strcmp(name, g_algo_names[a]) == 0) {
+          g_algo = prod_algo(a);
+          return;
+        }
+      std::cerr << "PROD_ALGO inconnu : " << name << std::endl;
+    }
+    if (hasBlockSize) g_algo = parallel_block1;
+  });
+}
+
+int maxThreads() {
+#if defined(_OPENMP)
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+// Les noyaux travaillent sur des tableaux rangés par colonnes, X(i,j) = X[i + j*ldX] : une matrice rangée
+// par lignes est la transposée d'une matrice rangée par colonnes ( cf. operator* ). Ordre j,k,i : pas
+// unitaire sur A et C dans la boucle interne.
+template <typename T>
+void prodSubBlocks(int iRowBlkA, int iColBlkB, int iColBlkA, int szBlock, int m, int n, int k,
+                   const T* A, int ldA, const T* B, int ldB, T* C, int ldC) {
+  const int iEnd = std::min(m, iRowBlkA + szBlock);
+  for (int j = iColBlkB; j < std::min(n, iColBlkB + szBlock); ++j)
+    for (int p = iColBlkA; p < std::min(k, iColBlkA + szBlock); ++p) {
+      const T b = B[p + std::size_t(j) * ldB];
+      const T* a = A + std::size_t(p) * ldA;
+      T* c = C + std::size_t(j) * ldC;
+      for (int i = iRowBlkA; i < iEnd; ++i)
+        c[i] += a[i] * b;
+    }
+}
+
+template <typename T>
+void prodNaive(int m, int n, int k, const T* A, int ldA, const T* B, int ldB, T* C, int ldC,
+               bool parallel) {
+#if defined(_OPENMP)
+  #pragma omp parallel for schedule(static) if (parallel)
+#endif
+  for (int j = 0; j < n; ++j)
+    for (int p = 0; p < k; ++p) {
+      const T b = B[p + std::size_t(j) * ldB];
+      const T* a = A + std::size_t(p) * ldA;
+      T* c = C + std::size_t(j) * ldC;
+      for (int i = 0; i < m; ++i)
+        c[i] += a[i] * b;
+    }
+}
+
+template <typename T>
+void prodBlock(int m, int n, int k, const T* A, int ldA, const T* B, int ldB, T* C, int ldC,
+               int blockSize) {
+  for (int j = 0; j < n; j += blockSize)
+    for (int p = 0; p < k; p += blockSize)
+      for (int i = 0; i < m; i += blockSize)
+        prodSubBlocks(i, j, p, blockSize, m, n, k, A, ldA, B, ldB, C, ldC);
+}
+
+template <typename T>
+void prodParallelBlock1(int m, int n, int k, const T* A, int ldA, const T* B, int ldB, T* C,
+                        int ldC, int blockSize) {
+#if defined(_OPENMP)
+  #pragma omp parallel for collapse(2) schedule(static)
+#endif
+  for (int i = 0; i < m; i += blockSize)
+    for (int j = 0; j < n; j += blockSize)
+      for (int p = 0; p < k; p += blockSize)
+        prodSubBlocks(i, j, p, blockSize, m, n, k, A, ldA, B, ldB, C, ldC);
+}
+
+template <typename T>
+void prodParallelBlock2(int m, int n, int k, const T* A, int ldA, const T* B, int ldB, T* C,
+                        int ldC, int blockSize) {
+#if defined(_OPENMP)
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for (int j = 0; j < n; j += blockSize)
+    for (int p = 0; p < k; p += blockSize)
+      for (int i = 0; i < m; i += blockSize)
+        prodSubBlocks(i, j, p, blockSize, m, n, k, A, ldA, B, ldB, C, ldC);
+}
+
+// Découpe récursive de C += A * B selon la plus grande des dimensions m, n, k, chaque moitié étant une tâche
+// OpenMP : les threads inoccupés prennent les tâches en attente des autres. Découper k ferait écrire les deux
+// moitiés dans le même C : la seconde accumule dans un C privé, ajouté à C une fois les deux tâches finies.
+// Les feuilles ( volume <= grain ) appellent gemmPacked, séquentiel dans une tâche ( région imbriquée ).
+template <typename T>
+void taskProduct(int m, int n, int k, const T* A, int ldA, const T* B, int ldB, T* C, int ldC,
+                 double grain) {
+  if (double(m) * n * k <= grain || std::max({m, n, k}) < 2 * gemmMicroRows<T>()) {
+    gemmPacked(m, n, k, A, ldA, B, ldB, C, ldC);
+    return;
+  }
+  if (m >= n && m >= k) {
+    const int m1 = (m / 2 + gemmMicroRows<T>() - 1) / gemmMicroRows<T>() * gemmMicroRows<T>();
+#if defined(_OPENMP)
+    #pragma omp task
+#endif
+    taskProduct(m1, n, k, A, ldA, B, ldB, C, ldC, grain);
+    taskProduct(m - m1, n, k, A + m1, ldA, B, ldB, C + m1, ldC, grain);
+  } else if (n >= k) {
+    const int n1 = (n / 2 + gemmMicroCols<T>() - 1) / gemmMicroCols<T>() * gemmMicroCols<T>();
+#if defined(_OPENMP)
+    #pragma omp task
+#endif
+    taskProduct(m, n1, k, A, ldA, B, ldB, C, ldC, grain);
+    taskProduct(m, n - n1, k, A, ldA, B + std::size_t(n1) * ldB, ldB, C + std::size_t(n1) * ldC, ldC, grain);
+  } else {
+    const int k1 = k / 2;
+    std::vector<T> acc(std::size_t(m) * n, T(0));
+#if defined(_OPENMP)
+    #pragma omp task
+#endif
+    taskProduct(m, n, k1, A, ldA, B, ldB, C, ldC, grain);
+    taskProduct(m, n, k - k1, A + std::size_t(k1) * ldA, ldA, B + k1, ldB, acc.data(), m, grain);
+#if defined(_OPENMP)
+    #pragma omp taskwait
+#endif
+    for (int j = 0; j < n; ++j) {
+      T* c = C + std::size_t(j) * ldC;
+      const T* a = acc.data() + std::size_t(j) * m;
+      for (int i = 0; i < m; ++i) c[i] += a[i];
+    }
+    return;
   }
-  return g_block_size;
+#if defined(_OPENMP)
+  #pragma omp taskwait
+#endif
 }
 
-/*void prodSubBlocks(int iRowBlkA, int iColBlkB, int iColBlkA, int szBlock,
-                   const Matrix& A, const Matrix& B, Matrix& C) {
-  for (int j = iColBlkB; j < std::min(B.nbCols, iColBlkB + szBlock); ++j)
-    for (int k = iColBlkA; k < std::min(A.nbCols, iColBlkA + szBlock); ++k)
-      for (int i = iRowBlkA; i < std::min(A.nbRows, iRowBlkA + szBlock); ++i)
-        C(i, j) += A(i, k) * B(k, j);
+template <typename T>
+void prodParallelTasks(int m, int n, int k, const T* A, int ldA, const T* B, int ldB, T* C,
+                       int ldC) {
+  const int threads = maxThreads();
+  if (threads == 1) {
+    gemmPacked(m, n, k, A, ldA, B, ldB, C, ldC);
+    return;
+  }
+  // Environ 8 feuilles par thread, mais pas de feuille trop petite pour le micro-noyau
+  const double grain = std::max(double(m) * n * k / (8. * threads), 64. * 64. * 64.);
+#if defined(_OPENMP)
+  #pragma omp parallel
+  #pragma omp single
+#endif
+  taskProduct(m, n, k, A, ldA, B, ldB, C, ldC, grain);
+}
+
+// Strassen n'existe qu'en double : les produits float passent par packed
+void runStrassen(int m, int n, int k, const double* A, int ldA, const double* B, int ldB, double* C, int ldC) {
+  gemmStrassen(m, n, k, A, ldA, B, ldB, C, ldC);
+}
+void runStrassen(int m, int n, int k, const float* A, int ldA, const float* B, int ldB, float* C, int ldC) {
+  gemmPacked(m, n, k, A, ldA, B, ldB, C, ldC);
+}
+
+// C(0:m,0:n) += A(0:m,0:k) * B(0:k,0:n), tous rangés par colonnes ( strassen écrase C, reçu nul )
+template <typename T>
+void runProduct(int m, int n, int k, const T* A, int ldA, const T* B, int ldB, T* C, int ldC,
+                prod_algo algo, int blockSize) {
+  switch (algo) {
+  case naive:           prodNaive(m, n, k, A, ldA, B, ldB, C, ldC, false); break;
+  case parallel_naive:  prodNaive(m, n, k, A, ldA, B, ldB, C, ldC, true); break;
+  case block:           prodBlock(m, n, k, A, ldA, B, ldB, C, ldC, blockSize); break;
+  case parallel_block1: prodParallelBlock1(m, n, k, A, ldA, B, ldB, C, ldC, blockSize); break;
+  case parallel_block2: prodParallelBlock2(m, n, k, A, ldA, B, ldB, C, ldC, blockSize); break;
+  case parallel_tasks:  prodParallelTasks(m, n, k, A, ldA, B, ldB, C, ldC); break;
+  case strassen:        runStrassen(m, n, k, A, ldA, B, ldB, C, ldC); break;
+  case packed:
+  case automatic:
+    gemmPacked(m, n, k, A, ldA, B, ldB, C, ldC);
+    break;
+  }
+}
+
+/**
+ * Choisit l'algorithme et la taille de bloc les plus rapides pour chaque type de coefficients et chaque classe
+ * de forme ( chaque dimension classée petite < 128 <= moyenne < 1024 <= grande ). Une classe est mesurée à la
+ * première demande ( tuneProdMatMat, ou à défaut le premier produit qui y tombe ), sur des matrices du même
+ * type et de la même forme ramenée dans la classe ( dimension moyenne limitée à 512, grande ramenée à 1024 ).
+ * Le choix est ajouté au fichier de réglage avec la signature de la machine ( caches, nombre de threads ) et
+ * le type, pour ne plus être mesuré ensuite. Une grande classe coûte quelques produits de taille 1024.
+ */
+class Autotuner {
+public:
+  struct Choice {
+    prod_algo algo;
+    int block;
+  };
+
+  template <typename T> Choice choose(int m, int n, int k) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_loaded) load();
+    const auto key = std::make_pair(signature<T>(), shapeClass(m, n, k));
+    auto it = m_choices.find(key);
+    if (it != m_choices.end()) return it->second;
+    Choice best = tune<T>(tuningSize(m), tuningSize(n), tuningSize(k));
+    m_choices[key] = best;
+    save(key.first, key.second, best);
+    return best;
+  }
+
+private:
+  static int sizeClass(int d) { return d < 128 ? 0 : (d < 1024 ? 1 : 2); }
+  static int shapeClass(int m, int n, int k) { return 9 * sizeClass(m) + 3 * sizeClass(n) + sizeClass(k); }
+  // Dimension mesurée pour d : de la même classe que d, bornée pour limiter le coût du réglage
+  static int tuningSize(int d) { return d < 1024 ? std::min(d, 512) : 1024; }
+
+  static std::string fileName() {
+    const char* env = std::getenv("PROD_TUNING");
+    return (env && *env) ? env : "prodmatmat.tuning";
+  }
 
-}*/
+  template <typename T> static std::string signature() {
+    std::ostringstream sig;
+    sig << "L1=" << sysconf(_SC_LEVEL1_DCACHE_SIZE) << ",L2=" << sysconf(_SC_LEVEL2_CACHE_SIZE)
+        << ",L3=" << sysconf(_SC_LEVEL3_CACHE_SIZE) << ",threads=" << maxThreads()
+        << ",type=" << (std::is_same<T, float>::value ? "float" : "double");
+    return sig.str();
+  }
 
-// Orden optimizado: i, k, j
-void prodSubBlocks(int iRowBlkA, int iColBlkB, int iColBlkA, int szBlock,
-                   const Matrix& A, const Matrix& B, Matrix& C) {
-  for (int i = iRowBlkA; i < std::min(A.nbRows, iRowBlkA + szBlock); ++i) {
-    for (int k = iColBlkA; k < std::min(A.nbCols, iColBlkA + szBlock); ++k) {
-      for (int j = iColBlkB; j < std::min(B.nbCols, iColBlkB + szBlock); ++j) {
-        C(i, j) += A(i, k) * B(k, j);
+  // Toutes les lignes sont gardées : la signature de la clé suit le nombre de threads courant et le type
+  void load() {
+    m_loaded = true;
+    std::ifstream in(fileName());
+    std::string lineSig, algoName;
+    int cls, blk;
+    while (in >> lineSig >> cls >> algoName >> blk)
+      for (int a = naive; a < automatic; ++a)
+        if (algoName == g_algo_names[a]) m_choices[std::make_pair(lineSig, cls)] = Choice{prod_algo(a), blk};
+  }
+
+  // Le fichier est recopié avec la nouvelle ligne dans un fichier temporaire propre au processus, puis renommé :
+  // rename étant atomique, des processus concurrents ( rangs MPI ) ne peuvent pas entrelacer leurs lignes. Au
+  // pire, un choix écrit au même moment par un autre processus est perdu et sera mesuré de nouveau.
+  void save(const std::string& sig, int cls, const Choice& c) const {
+    const std::string name = fileName(), tmp = name + ".tmp" + std::to_string(getpid());
+    {
+      std::ifstream in(name);
+      std::ofstream out(tmp, std::ios::trunc);
+      std::string line;
+      while (std::getline(in, line))
+        if (!line.empty()) out << line << "\n";
+      out << sig << " " << cls << " " << g_algo_names[c.algo] << " " << c.block << "\n";
+      if (!out) {
+        out.close();
+        std::remove(tmp.c_str());
+        return;
       }
     }
+    if (std::rename(tmp.c_str(), name.c_str()) != 0) std::remove(tmp.c_str());
   }
-}
 
+  template <typename T> static Choice tune(int m, int n, int k) {
+    BasicMatrix<T, ColMajor> A(m, k, T(1)), B(k, n, T(1));
+    std::vector<Choice> candidates{{packed, 0}, {parallel_naive, 0}};
+    const bool sequential = (maxThreads() == 1);
+    for (int blk : {32, 64, 128, 256}) {
+      if (blk > 2 * std::max({m, n, k})) break;
+      if (sequential)
+        candidates.push_back({block, blk});
+      else {
+        candidates.push_back({parallel_block1, blk});
+        candidates.push_back({parallel_block2, blk});
+      }
+    }
+    if (sequential)
+      candidates.push_back({naive, 0});
+    else
+      candidates.push_back({parallel_tasks, 0});
+
+    Choice best = candidates.front();
+    double bestTime = -1.;
+    for (const Choice& c : candidates) {
+      double t = 0.;
+      // Une exécution de chauffe, puis le meilleur de deux ( on abandonne vite les candidats très lents )
+      for (int rep = 0; rep < 3; ++rep) {
+        BasicMatrix<T, ColMajor> C(m, n, T(0));
+        auto start = std::chrono::steady_clock::now();
+        runProduct(m, n, k, A.data(), A.ld(), B.data(), B.ld(), C.data(), C.ld(), c.algo, c.block);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (rep == 1 || (rep == 2 && elapsed < t)) t = elapsed;
+        if (rep == 0 && bestTime > 0. && elapsed > 4. * bestTime) {
+          t = elapsed;
+          break;
+        }
+      }
+      if (bestTime < 0. || t < bestTime) {
+        bestTime = t;
+        best = c;
+      }
+    }
+    return best;
+  }
+
+  std::mutex m_mutex;
+  bool m_loaded = false;
+  std::map<std::pair<std::string, int>, Choice> m_choices;
+};
+
+Autotuner& autotuner() {
+  static Autotuner tuner;
+  return tuner;
+}
 }  // namespace
 
+void setProdMatMat(prod_algo algo) {
+  g_algo = algo;
+  g_algo_set = true;
+}
+
+prod_algo getProdMatMat() {
+  readEnvironment();
+  return g_algo;
+}
+
+const char* prodAlgoName(prod_algo algo) { return g_algo_names[algo]; }
+
 void setBlockSize(int size) {
+  readEnvironment();
   if (size > 0)
     g_block_size = size;
 }
@@ -58,15 +382,155 @@ void setNbThreads(int n) {
 #endif
 }
 
-Matrix operator*(const Matrix& A, const Matrix& B) {
-  Matrix C(A.nbRows, B.nbCols, 0.0);
-  const int block = getBlockSize();
-#if defined(_OPENMP)
-  #pragma omp parallel for collapse(2) schedule(static)
-#endif
-  for (int i = 0; i < A.nbRows; i += block)
-    for (int j = 0; j < B.nbCols; j += block)
-      for (int k = 0; k < A.nbCols; k += block)
-        prodSubBlocks(i, j, k, block, A, B, C);
+namespace {
+// Produit de deux matrices de même rangement. Une matrice rangée par lignes de leading dimension ld est la
+// transposée d'une matrice rangée par colonnes de même ld : pour RowMajor on calcule C^T = B^T * A^T avec
+// les noyaux par colonnes, sans aucune copie.
+template <typename T, typename L>
+void runProduct(const MatrixView<const T, L>& A, const MatrixView<const T, L>& B, const MatrixView<T, L>& C,
+                prod_algo algo, int blockSize) {
+  if (L::isColMajor)
+    runProduct(A.nbRows, B.nbCols, A.nbCols, A.data(), A.ld(), B.data(), B.ld(), C.data(), C.ld(), algo,
+               blockSize);
+  else
+    runProduct(B.nbCols, A.nbRows, A.nbCols, B.data(), B.ld(), A.data(), A.ld(), C.data(), C.ld(), algo,
+               blockSize);
+}
+
+// C = alpha * A * B + beta * C avec le moteur packed de la précision de T ( gemmPackedMixed en mode mixte )
+template <typename LA, typename LB, typename LC>
+void packedGemm(double alpha, const MatrixView<const double, LA>& A, const MatrixView<const double, LB>& B,
+                double beta, const MatrixView<double, LC>& C) {
+  gemmPacked<LA, LB, LC>(C.nbRows, C.nbCols, A.nbCols, alpha, A.data(), A.ld(), B.data(), B.ld(), beta,
+                         C.data(), C.ld());
+}
+
+template <typename LA, typename LB, typename LC>
+void packedGemm(double alpha, const MatrixView<const float, LA>& A, const MatrixView<const float, LB>& B,
+                double beta, const MatrixView<float, LC>& C) {
+  if (getMixedPrecision())
+    gemmPackedMixed<LA, LB, LC>(C.nbRows, C.nbCols, A.nbCols, alpha, A.data(), A.ld(), B.data(), B.ld(), beta,
+                                C.data(), C.ld());
+  else
+    gemmPacked<LA, LB, LC>(C.nbRows, C.nbCols, A.nbCols, float(alpha), A.data(), A.ld(), B.data(), B.ld(),
+                           float(beta), C.data(), C.ld());
+}
+
+// Algorithme et taille de bloc du produit simple A * B ( m x k par k x n ) : l'algorithme courant, ou celui de
+// l'autotuner, mesuré avec le type T. En précision mixte, seul packed accumule en double : tous les produits
+// float y passent.
+template <typename T, typename L>
+Autotuner::Choice selectAlgo(int m, int n, int k) {
+  readEnvironment();
+  Autotuner::Choice choice{g_algo, g_block_size};
+  if (std::is_same<T, float>::value && g_mixed) choice.algo = packed;
+  if (choice.algo == automatic) {
+    // En RowMajor les noyaux voient le produit transposé, de forme n x m
+    Autotuner::Choice tuned = L::isColMajor ? autotuner().choose<T>(m, n, k) : autotuner().choose<T>(n, m, k);
+    choice.algo = tuned.algo;
+    if (tuned.block > 0) choice.block = tuned.block;
+  }
+  return choice;
+}
+
+// Produit simple C = A * B avec l'algorithme choisi par selectAlgo
+template <typename T, typename L>
+void dispatchProduct(const MatrixView<const T, L>& A, const MatrixView<const T, L>& B, const MatrixView<T, L>& C) {
+  const Autotuner::Choice choice = selectAlgo<T, L>(A.nbRows, B.nbCols, A.nbCols);
+  const prod_algo algo = choice.algo;
+  const int blockSize = choice.block;
+  if (algo == packed) {
+    packedGemm(1., A, B, 0., C);
+    return;
+  }
+  // Les autres algorithmes ajoutent à C
+  for (int i = 0; i < C.nbRows; ++i)
+    for (int j = 0; j < C.nbCols; ++j) C(i, j) = T(0);
+  runProduct(A, B, C, algo, blockSize);
+}
+
+template <typename T, typename LA, typename LB, typename LC>
+bool tryDispatch(double, const MatrixView<const T, LA>&, const MatrixView<const T, LB>&, double,
+                 const MatrixView<T, LC>&) {
+  return false;
+}
+
+template <typename T, typename L>
+bool tryDispatch(double alpha, const MatrixView<const T, L>& A, const MatrixView<const T, L>& B, double beta,
+                 const MatrixView<T, L>& C) {
+  if (alpha != 1. || beta != 0.) return false;
+  dispatchProduct(A, B, C);
+  return true;
+}
+}  // namespace
+
+void setMixedPrecision(bool mixed) {
+  readEnvironment();
+  g_mixed = mixed;
+}
+
+bool getMixedPrecision() {
+  readEnvironment();
+  return g_mixed;
+}
+
+template <typename T, typename L>
+void tuneProdMatMat(const BasicMatrix<T, L>& A, const BasicMatrix<T, L>& B) {
+  assert(A.nbCols == B.nbRows);
+  selectAlgo<T, L>(A.nbRows, B.nbCols, A.nbCols);
+}
+
+template <typename T, typename L>
+BasicMatrix<T, L> prodMatMat(const BasicMatrix<T, L>& A, const BasicMatrix<T, L>& B, prod_algo algo,
+                             int blockSize) {
+  assert(A.nbCols == B.nbRows);
+  BasicMatrix<T, L> C(A.nbRows, B.nbCols, T(0));
+  if (std::is_same<T, float>::value && getMixedPrecision())
+    packedGemm(1., A.view(), B.view(), 0., C.view());
+  else
+    runProduct(A.view(), B.view(), C.view(), algo, blockSize > 0 ? blockSize : g_block_size);
   return C;
 }
+
+template <typename T, typename LA, typename LB, typename LC>
+void evalGemm(double alpha, const MatrixView<const T, LA>& A, const MatrixView<const T, LB>& B, double beta,
+              const MatrixView<T, LC>& C) {
+  assert(A.nbCols == B.nbRows && C.nbRows == A.nbRows && C.nbCols == B.nbCols);
+  if (storageOverlaps(C, A) || storageOverlaps(C, B)) {
+    // C = A * C par exemple : C serait modifié pendant qu'on le lit
+    BasicMatrix<T, LC> tmp(C.nbRows, C.nbCols);
+    evalGemm(alpha, A, B, 0., tmp.view());
+    for (int i = 0; i < C.nbRows; ++i)
+      for (int j = 0; j < C.nbCols; ++j) C(i, j) = T((beta == 0. ? 0. : beta * C(i, j)) + tmp(i, j));
+    return;
+  }
+  if (tryDispatch(alpha, A, B, beta, C)) return;
+  packedGemm(alpha, A, B, beta, C);
+}
+
+template void tuneProdMatMat(const Matrix&, const Matrix&);
+template void tuneProdMatMat(const RowMatrix&, const RowMatrix&);
+template void tuneProdMatMat(const FloatMatrix&, const FloatMatrix&);
+template void tuneProdMatMat(const FloatRowMatrix&, const FloatRowMatrix&);
+
+template Matrix prodMatMat(const Matrix&, const Matrix&, prod_algo, int);
+template RowMatrix prodMatMat(const RowMatrix&, const RowMatrix&, prod_algo, int);
+template FloatMatrix prodMatMat(const FloatMatrix&, const FloatMatrix&, prod_algo, int);
+template FloatRowMatrix prodMatMat(const FloatRowMatrix&, const FloatRowMatrix&, prod_algo, int);
+
+#define EVALGEMM_INSTANTIATE(T, LA, LB, LC)                                                                \
+  template void evalGemm<T, LA, LB, LC>(double, const MatrixView<const T, LA>&, const MatrixView<const T, LB>&, \
+                                        double, const MatrixView<T, LC>&);
+#define EVALGEMM_INSTANTIATE_LAYOUTS(T)               \
+  EVALGEMM_INSTANTIATE(T, ColMajor, ColMajor, ColMajor) \
+  EVALGEMM_INSTANTIATE(T, ColMajor, ColMajor, RowMajor) \
+  EVALGEMM_INSTANTIATE(T, ColMajor, RowMajor, ColMajor) \
+  EVALGEMM_INSTANTIATE(T, ColMajor, RowMajor, RowMajor) \
+  EVALGEMM_INSTANTIATE(T, RowMajor, ColMajor, ColMajor) \
+  EVALGEMM_INSTANTIATE(T, RowMajor, ColMajor, RowMajor) \
+  EVALGEMM_INSTANTIATE(T, RowMajor, RowMajor, ColMajor) \
+  EVALGEMM_INSTANTIATE(T, RowMajor, RowMajor, RowMajor)
+EVALGEMM_INSTANTIATE_LAYOUTS(double)
+EVALGEMM_INSTANTIATE_LAYOUTS(float)
+#undef EVALGEMM_INSTANTIATE_LAYOUTS
+#undef EVALGEMM_INSTANTIATE
@@ -1,12 +1,76 @@
 #ifndef _ProdMatMat_hpp__
 # define _ProdMatMat_hpp__
 # include <functional>
+# include <type_traits>
 #include "Matrix.hpp"
+#include "Gemm.hpp"
+#include "GemmExpr.hpp"
 
-Matrix operator* ( const Matrix& A, const Matrix& B );
-
-enum prod_algo { naive, block, parallel_naive, parallel_block1, parallel_block2 } ;
+/**
+ * operator* ( cf. GemmExpr.hpp ) construit une expression évaluée à l'affectation : Matrix C = A * B;
+ * C += A * B; C = alpha * A.t() * B + beta * C; ... Un produit simple ( ni alpha, ni beta, même rangement
+ * pour A, B et C ) utilise l'algorithme choisi ci-dessous, les autres formes gemmPacked en un seul passage.
+ * En RowMajor, les noyaux calculent C^T = B^T * A^T. Tout vaut aussi pour des matrices float ( FloatMatrix,
+ * FloatRowMatrix ) : mêmes noyaux en simple précision, micro-noyau packed de 16 x 6 floats.
+ *
+ * Algorithmes disponibles pour les produits simples :
+ *   naive           : triple boucle j,k,i ( pas unitaire sur A et C )
+ *   block           : produit par blocs de taille setBlockSize(), séquentiel
+ *   parallel_naive  : triple boucle, colonnes de C réparties entre threads
+ *   parallel_block1 : produit par blocs, couples de blocs (i,j) de C répartis entre threads
+ *   parallel_block2 : produit par blocs, bandes de colonnes de C réparties entre threads
+ *   parallel_tasks  : tâches OpenMP, découpe récursive selon la plus grande dimension ( y compris k, avec
+ *                     un C privé par moitié ) : adapté aux formes très rectangulaires
+ *   packed          : produit "à la BLIS" de Gemm.hpp ( blocs recopiés + micro-noyau )
+ *   strassen        : Strassen-Winograd de Strassen.hpp au-dessus de packed ( moins précis, jamais choisi
+ *                     par l'autotuner )
+ *   automatic       : choix par l'autotuner selon la forme du produit et le type des coefficients ( valeur
+ *                     par défaut ) ; mesuré au premier produit de chaque classe de forme, sauf appel préalable
+ *                     à tuneProdMatMat
+ *
+ * Variables d'environnement lues une seule fois, au premier produit :
+ *   PROD_ALGO      : nom d'un des algorithmes ci-dessus
+ *   BLOCK_SIZE     : taille de bloc ; sans PROD_ALGO, sélectionne parallel_block1 ( mesures du TP )
+ *   PROD_TUNING    : fichier où l'autotuner conserve ses choix ( défaut : prodmatmat.tuning )
+ *   PROD_MIXED     : 1 pour la précision mixte ( cf. setMixedPrecision )
+ */
+enum prod_algo { naive, block, parallel_naive, parallel_block1, parallel_block2, parallel_tasks, packed, strassen,
+                 automatic } ;
 void setProdMatMat( prod_algo algo );
+prod_algo getProdMatMat();
 void setBlockSize( int size );
 void setNbThreads( int n );
+const char* prodAlgoName( prod_algo algo );
+
+/**
+ * Précision mixte pour les produits de matrices float : coefficients stockés en float ( mémoire et bande
+ * passante divisées par deux ), produits et sommes faits en double par gemmPackedMixed, quel que soit
+ * l'algorithme choisi. Désactivée par défaut : les produits float sont alors entièrement en float.
+ */
+void setMixedPrecision( bool mixed );
+bool getMixedPrecision();
+
+/**
+ * Règle d'avance l'algorithme automatic pour le produit A * B : si la classe de forme du produit n'est pas
+ * encore dans le fichier de réglage ( PROD_TUNING ), l'autotuner la mesure maintenant, avec le type des
+ * coefficients de A et B, et y ajoute son choix. À appeler avant une mesure de temps de operator*. Sans effet
+ * si un autre algorithme est choisi.
+ */
+template <typename T, typename L>
+void tuneProdMatMat( const BasicMatrix<T, L>& A, const BasicMatrix<T, L>& B );
+
+/// Produit avec un algorithme et une taille de bloc donnés, sans passer par l'autotuner
+template <typename T, typename L>
+BasicMatrix<T, L> prodMatMat( const BasicMatrix<T, L>& A, const BasicMatrix<T, L>& B, prod_algo algo,
+                              int blockSize );
+
+/// C += A * B où A, B et C sont des matrices ou des vues ( MatrixView ) de rangements quelconques
+template <typename MA, typename MB, typename MC>
+void multiplyAdd( const MA& A, const MB& B, MC&& C )
+{
+  using LC = typename std::decay<MC>::type::layout;
+  using T = typename std::remove_const<typename MA::value_type>::type;
+  gemmPacked<typename MA::layout, typename MB::layout, LC>( A.nbRows, B.nbCols, A.nbCols, T(1), A.data(), A.ld(),
+                                                            B.data(), B.ld(), T(1), C.data(), C.ld() );
+}
 #endif
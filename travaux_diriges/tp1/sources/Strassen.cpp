@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <vector>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "Strassen.hpp"
+#include "Gemm.hpp"
+
+namespace {
+int g_cutoff = 1024;
+std::once_flag g_env_once;
+
+void readEnvironment() {
+  std::call_once(g_env_once, [] {
+    const char* env = std::getenv("STRASSEN_CUTOFF");
+    if (env && *env && std::atoi(env) > 0) g_cutoff = std::atoi(env);
+  });
+}
+
+struct Context {
+  int cutoff;
+  int taskDepth;  // niveaux dont les sous-produits sont des tâches OpenMP
+};
+
+// Taille d'un quart arrondie à une ligne de cache, pour que chaque tampon de la zone de travail reste aligné
+std::size_t quarter(int rows, int cols) { return (std::size_t(rows) * cols + 7) / 8 * 8; }
+
+bool isLeaf(int m, int n, int k, const Context& ctx) { return std::min({m, n, k}) <= ctx.cutoff; }
+
+// Zone de travail d'un appel : S1..S4, T1..T4, P1, P5, P6 puis celle des sous-produits ( une par tâche )
+std::size_t workspace(int m, int n, int k, int depth, const Context& ctx) {
+  if (isLeaf(m, n, k, ctx)) return 0;
+  const int m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  const std::size_t own = 4 * quarter(m2, k2) + 4 * quarter(k2, n2) + 3 * quarter(m2, n2);
+  return own + (depth < ctx.taskDepth ? 7 : 1) * workspace(m2, n2, k2, depth + 1, ctx);
+}
+
+// Z = X + sign * Y ( Z peut être X ou Y )
+void combine(int m, int n, const double* X, int ldX, const double* Y, int ldY, double* Z, int ldZ, double sign) {
+  for (int j = 0; j < n; ++j) {
+    const double* x = X + std::size_t(j) * ldX;
+    const double* y = Y + std::size_t(j) * ldY;
+    double* z = Z + std::size_t(j) * ldZ;
+    for (int i = 0; i < m; ++i) z[i] = x[i] + sign * y[i];
+  }
+}
+
+void setZero(int m, int n, double* C, int ldC) {
+  for (int j = 0; j < n; ++j) std::fill_n(C + std::size_t(j) * ldC, m, 0.);
+}
+
+struct SubProduct {
+  const double* X;
+  int ldX;
+  const double* Y;
+  int ldY;
+  double* Z;
+  int ldZ;
+};
+
+void strassenRec(int m, int n, int k, const double* A, int ldA, const double* B, int ldB, double* C, int ldC,
+                 double* ws, int depth, const Context& ctx) {
+  if (isLeaf(m, n, k, ctx)) {
+    setZero(m, n, C, ldC);
+    gemmPacked(m, n, k, A, ldA, B, ldB, C, ldC);
+    return;
+  }
+  const int m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  const double *A11 = A, *A21 = A + m2, *A12 = A + std::size_t(k2) * ldA, *A22 = A12 + m2;
+  const double *B11 = B, *B21 = B + k2, *B12 = B + std::size_t(n2) * ldB, *B22 = B12 + k2;
+  double *C11 = C, *C21 = C + m2, *C12 = C + std::size_t(n2) * ldC, *C22 = C12 + m2;
+
+  double* S[4];
+  double* T[4];
+  for (int i = 0; i < 4; ++i, ws += quarter(m2, k2)) S[i] = ws;
+  for (int i = 0; i < 4; ++i, ws += quarter(k2, n2)) T[i] = ws;
+  double* P1 = ws;
+  double* P5 = P1 + quarter(m2, n2);
+  double* P6 = P5 + quarter(m2, n2);
+  ws = P6 + quarter(m2, n2);
+
+  combine(m2, k2, A21, ldA, A22, ldA, S[0], m2, 1.);     // S1 = A21 + A22
+  combine(m2, k2, S[0], m2, A11, ldA, S[1], m2, -1.);    // S2 = S1 - A11
+  combine(m2, k2, A11, ldA, A21, ldA, S[2], m2, -1.);    // S3 = A11 - A21
+  combine(m2, k2, A12, ldA, S[1], m2, S[3], m2, -1.);    // S4 = A12 - S2
+  combine(k2, n2, B12, ldB, B11, ldB, T[0], k2, -1.);    // T1 = B12 - B11
+  combine(k2, n2, B22, ldB, T[0], k2, T[1], k2, -1.);    // T2 = B22 - T1
+  combine(k2, n2, B22, ldB, B12, ldB, T[2], k2, -1.);    // T3 = B22 - B12
+  combine(k2, n2, T[1], k2, B21, ldB, T[3], k2, -1.);    // T4 = T2 - B21
+
+  // P2, P3, P4 et P7 sont calculés directement dans les quarts de C
+  const SubProduct products[7] = {
+      {A11, ldA, B11, ldB, P1, m2},    // P1 = A11 * B11
+      {A12, ldA, B21, ldB, C11, ldC},  // P2 = A12 * B21
+      {S[3], m2, B22, ldB, C12, ldC},  // P3 = S4 * B22
+      {A22, ldA, T[3], k2, C21, ldC},  // P4 = A22 * T4
+      {S[0], m2, T[0], k2, P5, m2},    // P5 = S1 * T1
+      {S[1], m2, T[1], k2, P6, m2},    // P6 = S2 * T2
+      {S[2], m2, T[2], k2, C22, ldC},  // P7 = S3 * T3
+  };
+  const bool spawn = depth < ctx.taskDepth;
+  const std::size_t subWorkspace = spawn ? workspace(m2, n2, k2, depth + 1, ctx) : 0;
+  for (int i = 0; i < 7; ++i) {
+#if defined(_OPENMP)
+    #pragma omp task firstprivate(i) if (spawn)
+#endif
+    strassenRec(m2, n2, k2, products[i].X, products[i].ldX, products[i].Y, products[i].ldY, products[i].Z,
+                products[i].ldZ, ws + i * subWorkspace, depth + 1, ctx);
+  }
+#if defined(_OPENMP)
+  #pragma omp taskwait
+#endif
+
+  combine(m2, n2, P1, m2, C11, ldC, C11, ldC, 1.);    // C11 = P1 + P2
+  combine(m2, n2, P6, m2, P1, m2, P6, m2, 1.);        // U2 = P1 + P6
+  combine(m2, n2, C22, ldC, P6, m2, C22, ldC, 1.);    // U3 = U2 + P7
+  combine(m2, n2, C22, ldC, C21, ldC, C21, ldC, -1.); // C21 = U3 - P4
+  combine(m2, n2, C22, ldC, P5, m2, C22, ldC, 1.);    // C22 = U3 + P5
+  combine(m2, n2, P5, m2, P6, m2, P5, m2, 1.);        // U4 = U2 + P5
+  combine(m2, n2, C12, ldC, P5, m2, C12, ldC, 1.);    // C12 = U4 + P3
+
+  // Peeling : dernier terme en k, dernière colonne, dernière ligne
+  if (k % 2)
+    gemmPacked(2 * m2, 2 * n2, 1, A + std::size_t(k - 1) * ldA, ldA, B + (k - 1), ldB, C, ldC);
+  if (n % 2) {
+    double* c = C + std::size_t(n - 1) * ldC;
+    setZero(m, 1, c, ldC);
+    gemmPacked(m, 1, k, A, ldA, B + std::size_t(n - 1) * ldB, ldB, c, ldC);
+  }
+  if (m % 2) {
+    setZero(1, 2 * n2, C + (m - 1), ldC);
+    gemmPacked(1, 2 * n2, k, A + (m - 1), ldA, B, ldB, C + (m - 1), ldC);
+  }
+}
+
+int maxThreads() {
+#if defined(_OPENMP)
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+void strassenWithCutoff(int m, int n, int k, const double* A, int ldA, const double* B, int ldB, double* C,
+                        int ldC, int cutoff) {
+  const int threads = maxThreads();
+  const Context ctx{std::max(1, cutoff), threads == 1 ? 0 : (threads <= 7 ? 1 : 2)};
+  std::vector<double, AlignedAllocator<double>> arena(workspace(m, n, k, 0, ctx));
+  if (ctx.taskDepth == 0 || isLeaf(m, n, k, ctx)) {
+    strassenRec(m, n, k, A, ldA, B, ldB, C, ldC, arena.data(), 0, ctx);
+    return;
+  }
+#if defined(_OPENMP)
+  #pragma omp parallel
+  #pragma omp single
+#endif
+  strassenRec(m, n, k, A, ldA, B, ldB, C, ldC, arena.data(), 0, ctx);
+}
+
+double bestTime(int reps, const std::function<void()>& run) {
+  double best = -1.;
+  for (int rep = 0; rep < reps; ++rep) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (best < 0. || t < best) best = t;
+  }
+  return best;
+}
+}  // namespace
+
+void setStrassenCutoff(int cutoff) {
+  readEnvironment();
+  if (cutoff > 0) g_cutoff = cutoff;
+}
+
+int getStrassenCutoff() {
+  readEnvironment();
+  return g_cutoff;
+}
+
+void gemmStrassen(int m, int n, int k, const double* A, int ldA, const double* B, int ldB, double* C, int ldC) {
+  strassenWithCutoff(m, n, k, A, ldA, B, ldB, C, ldC, getStrassenCutoff());
+}
+
+Matrix strassenProduct(const Matrix& A, const Matrix& B) {
+  assert(A.nbCols == B.nbRows);
+  Matrix C(A.nbRows, B.nbCols);
+  gemmStrassen(A.nbRows, B.nbCols, A.nbCols, A.data(), A.ld(), B.data(), B.ld(), C.data(), C.ld());
+  return C;
+}
+
+int tuneStrassenCutoff() {
+  for (int c : {128, 256, 512, 1024}) {
+    const int n = 2 * c;
+    Matrix A(n, n, 1.), B(n, n, 1.), C(n, n);
+    const double classical = bestTime(2, [&] {
+      setZero(n, n, C.data(), C.ld());
+      gemmPacked(n, n, n, A.data(), A.ld(), B.data(), B.ld(), C.data(), C.ld());
+    });
+    const double oneLevel = bestTime(2, [&] {
+      strassenWithCutoff(n, n, n, A.data(), A.ld(), B.data(), B.ld(), C.data(), C.ld(), c);
+    });
+    if (oneLevel < classical) return c;
+  }
+  return 2048;
+}
@@ -0,0 +1,35 @@
+#ifndef _Strassen_hpp__
+# define _Strassen_hpp__
+# include "Matrix.hpp"
+
+/**
+ * Produit de Strassen-Winograd ( 7 produits et 15 additions de quarts par niveau ) sur des tableaux rangés
+ * par colonnes :
+ *
+ *     C(0:m,0:n) = A(0:m,0:k) * B(0:k,0:n)      ( C est écrasé )
+ *
+ * La récursion s'arrête dès que min(m,n,k) <= cutoff et passe alors au produit par blocs gemmPacked. Une
+ * dimension impaire est traitée par "peeling" : la partie paire passe par Strassen, la dernière ligne, colonne
+ * ou le dernier terme en k sont corrigés par des produits classiques. Toute la mémoire de travail
+ * ( 11 quarts par niveau ) est prise dans une seule zone allouée avant la récursion. Avec OpenMP, les sept
+ * sous-produits des premiers niveaux sont des tâches ( 7 par niveau, assez de niveaux pour occuper les threads ).
+ *
+ * Le résultat est moins précis que le produit classique : l'erreur en norme max croît comme
+ * ||A|| ||B|| eps avec un facteur qui augmente avec le nombre de niveaux ( cf. TestStrassen.exe ).
+ */
+void gemmStrassen(int m, int n, int k, const double* A, int ldA, const double* B, int ldB, double* C, int ldC);
+
+Matrix strassenProduct(const Matrix& A, const Matrix& B);
+
+/// Dimension de bascule vers le produit classique ( variable d'environnement STRASSEN_CUTOFF, défaut 1024 )
+void setStrassenCutoff(int cutoff);
+int getStrassenCutoff();
+
+/**
+ * Mesure, pour des produits carrés de taille 2c, un niveau de Strassen contre le produit classique et
+ * retourne le plus petit c gagnant parmi 128, 256, 512 et 1024 ( 2048 si aucun ). Ne modifie pas la valeur
+ * courante : setStrassenCutoff(tuneStrassenCutoff()) pour l'utiliser.
+ */
+int tuneStrassenCutoff();
+
+#endif
@@ -0,0 +1,71 @@
+#include <cstdlib>
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+#include "Matrix.hpp"
+#include "ProdMatMat.hpp"
+#include "BatchGemm.hpp"
+
+/*
+ * Compare, pour des lots de petites matrices carrées, operator* appelé sur chaque couple et gemmBatched.
+ *
+ * Usage : ./TestBatchGemm.exe [n1 n2 ...]
+ * Avec l'algorithme automatic, l'autotuner est réglé pour chaque taille avant la mesure ( tuneProdMatMat ) et
+ * écrit son choix dans le fichier de réglage ( prodmatmat.tuning du répertoire courant, ou PROD_TUNING ).
+ */
+int main(int nargs, char *vargs[])
+{
+  std::vector<int> sizes{4, 8, 12, 16, 32, 64};
+  if (nargs > 1)
+    {
+      sizes.clear();
+      for (int i = 1; i < nargs; ++i) sizes.push_back(atoi(vargs[i]));
+    }
+  bool isPassed = true;
+  std::cout << "  n | lot     | MFlops operator* | MFlops gemmBatched | écart max\n";
+  for (int dim : sizes)
+    {
+      // Environ 2^28 opérations par lot
+      const int batch = std::max(1, int((1L << 28) / (2L * dim * dim * dim)));
+      const long stride = long(dim) * dim;
+      std::vector<double> A(stride * batch), B(stride * batch), C(stride * batch);
+      std::vector<Matrix> As, Bs;
+      for (int b = 0; b < batch; ++b)
+	{
+	  As.emplace_back(dim, dim);
+	  Bs.emplace_back(dim, dim);
+	  for (int i = 0; i < dim; ++i)
+	    for (int j = 0; j < dim; ++j)
+	      {
+		As[b](i, j) = A[b * stride + i + j * dim] = std::cos(0.3 * i + 1.7 * j + b);
+		Bs[b](i, j) = B[b * stride + i + j * dim] = std::sin(0.9 * i - 0.4 * j + b);
+	      }
+	}
+
+      std::vector<Matrix> Cs;
+      Cs.reserve(batch);
+      tuneProdMatMat(As[0], Bs[0]);
+      auto start = std::chrono::steady_clock::now();
+      for (int b = 0; b < batch; ++b) Cs.emplace_back(As[b] * Bs[b]);
+      std::chrono::duration<double> tLoop = std::chrono::steady_clock::now() - start;
+
+      start = std::chrono::steady_clock::now();
+      gemmBatched(dim, dim, dim, 1., A.data(), dim, stride, B.data(), dim, stride, 0., C.data(), dim, stride, batch);
+      std::chrono::duration<double> tBatch = std::chrono::steady_clock::now() - start;
+
+      double maxErr = 0.;
+      for (int b = 0; b < batch; ++b)
+	for (int i = 0; i < dim; ++i)
+	  for (int j = 0; j < dim; ++j)
+	    maxErr = std::max(maxErr, std::fabs(Cs[b](i, j) - C[b * stride + i + j * dim]));
+      if (maxErr > 1e-12 * dim) isPassed = false;
+
+      const double flops = 2. * dim * dim * dim * batch;
+      std::cout << " " << dim << " | " << batch << " | " << flops / tLoop.count() / 1e6 << " | "
+		<< flops / tBatch.count() / 1e6 << " | " << maxErr << "\n";
+    }
+  std::cout << (isPassed ? "Test passed" : "Test failed") << std::endl;
+  return (isPassed ? EXIT_SUCCESS : EXIT_FAILURE);
+}
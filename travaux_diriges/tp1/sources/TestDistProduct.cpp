@@ -0,0 +1,82 @@
+#include <mpi.h>
+#include <cstdlib>
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <tuple>
+#include "DistMatrix.hpp"
+#include "TestTensors.hpp"
+
+// Chaque processus ne remplit que son bloc
+void initTensorMatrices(const std::vector < double >&u, const std::vector < double >&v, DistMatrix& A)
+{
+  Matrix& loc = A.local();
+  for (int irow = 0; irow < loc.nbRows; ++irow)
+    for (int jcol = 0; jcol < loc.nbCols; ++jcol)
+      loc(irow, jcol) = u[A.rowOffset() + irow] * v[A.colOffset() + jcol];
+}
+
+// verifProduct de TestProductMatrix restreint au bloc local
+bool verifProduct(const std::vector < double >&uA, std::vector < double >&vA,
+		  const std::vector < double >&uB, std::vector < double >&vB, const DistMatrix & C)
+{
+  double vAdotuB = dot(vA, uB);
+  const Matrix& loc = C.local();
+  for (int irow = 0; irow < loc.nbRows; irow++)
+    for (int jcol = 0; jcol < loc.nbCols; jcol++)
+      {
+	const int gRow = C.rowOffset() + irow, gCol = C.colOffset() + jcol;
+	if (!verifCoefficient(gRow, gCol, uA[gRow] * vAdotuB * vB[gCol], loc(irow, jcol)))
+	  return false;
+      }
+  return true;
+}
+
+int main(int nargs, char *vargs[])
+{
+  MPI_Init(&nargs, &vargs);
+  int rank, nbp;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nbp);
+
+  int dim = 1024, panelWidth = 256;
+  if (nargs > 1)
+    dim = atoi(vargs[1]);
+  if (nargs > 2)
+    panelWidth = atoi(vargs[2]);
+  std::vector < double >uA, vA, uB, vB;
+  std::tie(uA, vA, uB, vB) = computeTensors(dim);
+
+  bool isPassed;
+  {
+    ProcessGrid grid(MPI_COMM_WORLD);
+    DistMatrix A(grid, dim, dim), B(grid, dim, dim), C(grid, dim, dim);
+    initTensorMatrices(uA, vA, A);
+    initTensorMatrices(uB, vB, B);
+
+    MPI_Barrier(grid.gridComm);
+    double start = MPI_Wtime();
+    summa(A, B, C, panelWidth);
+    MPI_Barrier(grid.gridComm);
+    double elapsed = MPI_Wtime() - start;
+
+    int localPassed = verifProduct(uA, vA, uB, vB, C), passed;
+    MPI_Allreduce(&localPassed, &passed, 1, MPI_INT, MPI_LAND, grid.gridComm);
+    isPassed = passed;
+    if (rank == 0)
+      {
+	if (isPassed)
+	  {
+	    std::cout << "Test passed\n";
+	    std::cout << "Grille " << grid.nbRows << " x " << grid.nbCols << ", panneaux de " << panelWidth << "\n";
+	    std::cout << "Temps produit matrice-matrice SUMMA : " << elapsed << " secondes\n";
+	    std::cout << "MFlops -> " << (2.*dim*dim*dim)/elapsed/1000000 <<std::endl;
+	  }
+	else
+	  std::cout << "Test failed\n";
+      }
+  }
+  MPI_Finalize();
+  return (isPassed ? EXIT_SUCCESS : EXIT_FAILURE);
+}
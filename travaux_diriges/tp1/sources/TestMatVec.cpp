@@ -0,0 +1,144 @@
+#include <mpi.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include "DistMatrix.hpp"
+#include "MatVec.hpp"
+
+/*
+ * Produit matrice-vecteur de tp2/matvec*.py : A(i,j) = (i+j) % dim + 1, u(j) = j + 1. Tous les termes sont
+ * des entiers et les sommes restent exactes en double ( < 2^53 ) : le résultat doit être exact quel que soit
+ * l'ordre des sommes.
+ *
+ * Usage : mpirun -np P ./TestMatVec.exe [dim] [répétitions]
+ * Avec un seul processus, gemv est d'abord mesuré pour les deux rangements. Puis les deux découpages
+ * distribués sont comparés : blocs de lignes ( MPI_Allgatherv ) et blocs de colonnes ( MPI_Reduce_scatter ),
+ * pour A carrée ( dim x dim ) puis rectangulaire ( m x dim, m = 3 dim / 2 + 1 lignes ).
+ * Les temps sont le maximum sur les processus, le minimum sur les répétitions ; le débit compte la lecture
+ * de A ( 8 m dim octets ), à comparer à la bande passante mémoire ( STREAM ) des nœuds.
+ */
+
+double coefA(int i, int j, int dim) { return double((i + j) % dim + 1); }
+
+// v(i) = sum_j A(i,j) u(j) pour i dans [i0, i1)
+std::vector<double> expected(int dim, int i0, int i1)
+{
+  std::vector<double> v(i1 - i0, 0.);
+  for (int i = i0; i < i1; ++i)
+    for (int j = 0; j < dim; ++j)
+      v[i - i0] += coefA(i, j, dim) * (j + 1.);
+  return v;
+}
+
+double maxError(const std::vector<double>& y, const std::vector<double>& ref)
+{
+  double err = 0.;
+  for (std::size_t i = 0; i < y.size(); ++i) err = std::max(err, std::fabs(y[i] - ref[i]));
+  return err;
+}
+
+// Meilleur temps sur reps exécutions, chaque temps étant celui du processus le plus lent
+double measure(int reps, MPI_Comm comm, const std::function<void()>& run)
+{
+  double best = -1.;
+  for (int r = 0; r < reps; ++r)
+    {
+      MPI_Barrier(comm);
+      double t0 = MPI_Wtime();
+      run();
+      double t = MPI_Wtime() - t0, tMax;
+      MPI_Allreduce(&t, &tMax, 1, MPI_DOUBLE, MPI_MAX, comm);
+      if (best < 0. || tMax < best) best = tMax;
+    }
+  return best;
+}
+
+void report(const char* name, int m, int dim, double t, double err)
+{
+  std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(6)
+	    << t << " s  " << std::setprecision(2) << std::setw(8) << 8. * m * dim / t / 1e9 << " GB/s  erreur "
+	    << std::defaultfloat << err << std::endl;
+}
+
+int main(int nargs, char *vargs[])
+{
+  MPI_Init(&nargs, &vargs);
+  int rank, nbp;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nbp);
+
+  int dim = 4096, reps = 10;
+  if (nargs > 1)
+    dim = atoi(vargs[1]);
+  if (nargs > 2)
+    reps = std::max(1, atoi(vargs[2]));
+  std::vector<double> u(dim);
+  for (int j = 0; j < dim; ++j) u[j] = j + 1.;
+  const int c0 = blockStart(dim, nbp, rank), c1 = blockStart(dim, nbp, rank + 1);
+  bool isPassed = true;
+
+  if (nbp == 1)
+    {
+      Matrix A(dim, dim);
+      RowMatrix Ar(dim, dim);
+      for (int j = 0; j < dim; ++j)
+	for (int i = 0; i < dim; ++i) A(i, j) = coefA(i, j, dim);
+      for (int i = 0; i < dim; ++i)
+	for (int j = 0; j < dim; ++j) Ar(i, j) = coefA(i, j, dim);
+      const std::vector<double> ref = expected(dim, 0, dim);
+      std::vector<double> v;
+      double t = measure(reps, MPI_COMM_WORLD, [&] { v = A * u; });
+      double err = maxError(v, ref);
+      report("gemv ColMajor", dim, dim, t, err);
+      isPassed = isPassed && err == 0.;
+      t = measure(reps, MPI_COMM_WORLD, [&] { v = Ar * u; });
+      err = maxError(v, ref);
+      report("gemv RowMajor", dim, dim, t, err);
+      isPassed = isPassed && err == 0.;
+    }
+
+  for (int m : {dim, 3 * dim / 2 + 1})
+    {
+      if (rank == 0) std::cout << "A : " << m << " x " << dim << std::endl;
+      const int r0 = blockStart(m, nbp, rank), r1 = blockStart(m, nbp, rank + 1);
+
+      // Blocs de lignes : lignes [r0, r1), u complet
+      {
+	Matrix ALoc(r1 - r0, dim);
+	for (int j = 0; j < dim; ++j)
+	  for (int i = r0; i < r1; ++i) ALoc(i - r0, j) = coefA(i, j, dim);
+	std::vector<double> v;
+	double t = measure(reps, MPI_COMM_WORLD, [&] { matvecRowBlock(m, ALoc, u, v, MPI_COMM_WORLD); });
+	// Chaque processus vérifie une tranche de v ( complet partout )
+	const std::vector<double> ref = expected(dim, r0, r1);
+	double err = (int(v.size()) == m ? maxError(std::vector<double>(v.begin() + r0, v.begin() + r1), ref)
+		      : HUGE_VAL), errMax;
+	MPI_Allreduce(&err, &errMax, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+	if (rank == 0) report("lignes   ( MPI_Allgatherv )", m, dim, t, errMax);
+	isPassed = isPassed && errMax == 0.;
+      }
+
+      // Blocs de colonnes : colonnes [c0, c1), tranche de u ; v découpé en tranches de m
+      {
+	Matrix ALoc(m, c1 - c0);
+	for (int j = c0; j < c1; ++j)
+	  for (int i = 0; i < m; ++i) ALoc(i, j - c0) = coefA(i, j, dim);
+	std::vector<double> uLoc(u.begin() + c0, u.begin() + c1), vLoc;
+	double t = measure(reps, MPI_COMM_WORLD, [&] { matvecColBlock(ALoc, uLoc, vLoc, MPI_COMM_WORLD); });
+	double err = (int(vLoc.size()) == r1 - r0 ? maxError(vLoc, expected(dim, r0, r1)) : HUGE_VAL), errMax;
+	MPI_Allreduce(&err, &errMax, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+	if (rank == 0) report("colonnes ( MPI_Reduce_scatter )", m, dim, t, errMax);
+	isPassed = isPassed && errMax == 0.;
+      }
+    }
+
+  if (rank == 0)
+    std::cout << (isPassed ? "Test passed" : "Test failed") << " ( " << nbp << " processus, dim " << dim << " )"
+	      << std::endl;
+  MPI_Finalize();
+  return (isPassed ? EXIT_SUCCESS : EXIT_FAILURE);
+}
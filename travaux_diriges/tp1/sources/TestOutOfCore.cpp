@@ -0,0 +1,124 @@
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <tuple>
+#include "MatrixFile.hpp"
+#include "TestTensors.hpp"
+
+/*
+ * Produit C = A * B de matrices stockées dans des fichiers ( cf. MatrixFile.hpp ), sans jamais les avoir
+ * entières en mémoire : A et B sont générées tuile par tuile ( mêmes tenseurs que TestProductMatrix ), puis
+ * gemmOutOfCore calcule C et le résultat est vérifié tuile par tuile.
+ *
+ * Usage : ./TestOutOfCore.exe [dim] [tuile] [répertoire] [--depth D] [--keep]
+ *   dim        : dimension des matrices ( défaut 4096 )
+ *   tuile      : dimension des tuiles ( défaut 1024 )
+ *   répertoire : où écrire A.omat, B.omat et C.omat ( défaut . ), de préférence sur le disque visé
+ *   --depth D  : nombre d'étapes chargées en avance par le thread d'E/S ( défaut 2 )
+ *   --keep     : conserver les fichiers
+ */
+
+// Remplit le fichier tuile après tuile, dans l'ordre du fichier
+void initTensorMatrices(const std::vector < double >&u, const std::vector < double >&v, MatrixFile & A)
+{
+  for (int J = 0; J < A.nbTileCols(); ++J)
+    for (int I = 0; I < A.nbTileRows(); ++I)
+      {
+	double* t = A.tile(I, J);
+	for (int j = 0; j < A.tileWidth(J); ++j)
+	  for (int i = 0; i < A.tileHeight(I); ++i)
+	    t[i + std::size_t(j) * A.tileRows] = u[I * A.tileRows + i] * v[J * A.tileCols + j];
+	A.writeBack(I, J);
+      }
+}
+
+bool verifProduct(const std::vector < double >&uA, std::vector < double >&vA,
+		  const std::vector < double >&uB, std::vector < double >&vB, const MatrixFile & C)
+{
+  double vAdotuB = dot(vA, uB);
+  for (int J = 0; J < C.nbTileCols(); ++J)
+    for (int I = 0; I < C.nbTileRows(); ++I)
+      {
+	const double* t = C.tile(I, J);
+	for (int j = 0; j < C.tileWidth(J); ++j)
+	  for (int i = 0; i < C.tileHeight(I); ++i)
+	    {
+	      const int irow = I * C.tileRows + i, jcol = J * C.tileCols + j;
+	      const double val = t[i + std::size_t(j) * C.tileRows];
+	      if (!verifCoefficient(irow, jcol, uA[irow] * vAdotuB * vB[jcol], val))
+		return false;
+	    }
+      }
+  return true;
+}
+
+int main(int nargs, char *vargs[])
+{
+  int dim = 4096, tile = 1024, depth = 2;
+  std::string dir = ".";
+  bool keep = false;
+  int pos = 0;
+  for (int i = 1; i < nargs; ++i)
+    {
+      if (std::strcmp(vargs[i], "--depth") == 0 && i + 1 < nargs)
+	depth = std::atoi(vargs[++i]);
+      else if (std::strcmp(vargs[i], "--keep") == 0)
+	keep = true;
+      else if (pos == 0) { dim = std::atoi(vargs[i]); ++pos; }
+      else if (pos == 1) { tile = std::atoi(vargs[i]); ++pos; }
+      else dir = vargs[i];
+    }
+  const std::string nameA = dir + "/A.omat", nameB = dir + "/B.omat", nameC = dir + "/C.omat";
+
+  std::vector < double >uA, vA, uB, vB;
+  std::tie(uA, vA, uB, vB) = computeTensors(dim);
+  bool isPassed;
+  try
+    {
+      {
+	MatrixFile A(nameA, dim, dim, tile, tile), B(nameB, dim, dim, tile, tile);
+	initTensorMatrices(uA, vA, A);
+	initTensorMatrices(uB, vB, B);
+	A.flush();
+	B.flush();
+	MatrixFile C(nameC, dim, dim, tile, tile);
+      }
+      // Réouverture : A et B en lecture seule, comme des données d'entrée existantes
+      MatrixFile A(nameA), B(nameB), C(nameC, true);
+      std::chrono::time_point < std::chrono::steady_clock > start, end;
+      start = std::chrono::steady_clock::now();
+      OutOfCoreStats stats = gemmOutOfCore(A, B, C, depth);
+      C.flush();
+      end = std::chrono::steady_clock::now();
+      std::chrono::duration < double >elapsed_seconds = end - start;
+
+      isPassed = verifProduct(uA, vA, uB, vB, C);
+      if (isPassed)
+	{
+	  std::cout << "Test passed\n";
+	  std::cout << "Temps produit hors mémoire ( tuiles " << tile << " ) : " << elapsed_seconds.count()
+		    << " secondes dont calcul " << stats.computeTime << " et attente des E/S " << stats.ioWaitTime
+		    << "\n";
+	  std::cout << "MFlops -> " << (2.*dim*dim*dim)/elapsed_seconds.count()/1000000 <<std::endl;
+	}
+      else
+	std::cout << "Test failed\n";
+    }
+  catch (const std::exception& e)
+    {
+      std::cerr << e.what() << std::endl;
+      isPassed = false;
+    }
+  if (!keep)
+    {
+      std::remove(nameA.c_str());
+      std::remove(nameB.c_str());
+      std::remove(nameC.c_str());
+    }
+  return (isPassed ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -4,88 +4,181 @@
 #include <cmath>
 #include <iostream>
 #include <chrono>
+#include <limits>
+#include <string>
 #include "Matrix.hpp"
 #include "ProdMatMat.hpp"
+#include "TestTensors.hpp"
 
-std::tuple<std::vector<double>,std::vector<double>,
-	   std::vector<double>,std::vector<double>>  computeTensors(int dim)
+template <typename T>
+BasicMatrix<T, ColMajor> initTensorMatrices(const std::vector < double >&u, const std::vector < double >&v)
 {
-  double pi = std::acos(-1.0);
-  auto u1 = std::vector < double >(dim);
-  auto u2 = std::vector < double >(dim);
-  auto v1 = std::vector < double >(dim);
-  auto v2 = std::vector < double >(dim);
-
-  for (int i = 0; i < dim; i++)
-    {
-      u1[i] = std::cos(1.67 * i * pi / dim);
-      u2[i] = std::sin(2.03 * i * pi / dim + 0.25);
-      v1[i] = std::cos(1.23 * i * i * pi / (7.5 * dim));
-      v2[i] = std::sin(0.675 * i / (3.1 * dim));
-    }
-  return std::make_tuple(u1, u2, v1, v2);
-}
-
-Matrix initTensorMatrices(const std::vector < double >&u, const std::vector < double >&v)
-{
-  Matrix A(u.size(), v.size());
+  BasicMatrix<T, ColMajor> A(u.size(), v.size());
   for (unsigned long irow = 0UL; irow < u.size(); ++irow)
     for (unsigned long jcol = 0UL; jcol < v.size(); ++jcol)
-      A(irow, jcol) = u[irow] * v[jcol];
+      A(irow, jcol) = T(u[irow] * v[jcol]);
   return A;
 }
 
-double dot(const std::vector < double >&u, const std::vector < double >&v)
+bool verifProduct(const std::vector < double >&uA, std::vector < double >&vA,
+		  const std::vector < double >&uB, std::vector < double >&vB, const Matrix & C)
 {
-  assert(u.size() == v.size());
-  double scal = 0.0;
-  for (unsigned long i = 0UL; i < u.size(); ++i)
-    scal += u[i] * v[i];
-  return scal;
+  double vAdotuB = dot(vA, uB);
+  for (int irow = 0; irow < C.nbRows; irow++)
+    for (int jcol = 0; jcol < C.nbCols; jcol++)
+      {
+	if (!verifCoefficient(irow, jcol, uA[irow] * vAdotuB * vB[jcol], C(irow, jcol)))
+	  return false;
+      }
+  return true;
 }
 
+/*
+ * Vérification en simple précision : l'arrondi en float des coefficients de A et B ( eps/2 chacun ) fausse déjà
+ * chaque terme du produit scalaire, et les sommes d'un produit en float perdent environ sqrt(k)*eps. L'erreur
+ * est donc comparée à eps(float) * |uA[i]| * |vB[j]| * sum_k |vA[k]*uB[k]| ( borne indépendante des
+ * compensations ) plutôt qu'à |C(i,j)| : au plus tolFactor fois cette quantité.
+ */
 bool verifProduct(const std::vector < double >&uA, std::vector < double >&vA,
-		  const std::vector < double >&uB, std::vector < double >&vB, const Matrix & C)
+		  const std::vector < double >&uB, std::vector < double >&vB, const FloatMatrix & C,
+		  double tolFactor)
 {
   double vAdotuB = dot(vA, uB);
+  double absDot = 0.;
+  for (unsigned long k = 0UL; k < vA.size(); ++k)
+    absDot += std::fabs(vA[k] * uB[k]);
+  const double eps = std::numeric_limits < float >::epsilon();
+  double maxRatio = 0.;
   for (int irow = 0; irow < C.nbRows; irow++)
     for (int jcol = 0; jcol < C.nbCols; jcol++)
       {
 	double rightVal = uA[irow] * vAdotuB * vB[jcol];
-	if (std::fabs(rightVal - C(irow, jcol)) >
-	    100*std::fabs(C(irow, jcol) * std::numeric_limits < double >::epsilon()))
+	double scale = eps * std::fabs(uA[irow] * vB[jcol]) * absDot;
+	double err = std::fabs(rightVal - C(irow, jcol));
+	if (err > tolFactor * scale)
 	  {
 	    std::
 	      cerr << "Erreur numérique : valeur attendue pour C( " << irow << ", " << jcol
 		   << " ) -> " << rightVal << " mais valeur trouvée : " << C(irow,jcol) << std::endl;
 	    return false;
 	  }
+	if (scale > 0.) maxRatio = std::max(maxRatio, err / scale);
       }
+  std::cout << "Erreur max : " << maxRatio << " eps(float) ( tolérance : " << tolFactor << " )\n";
   return true;
 }
 
+// Produit de référence X * Y ( m x k par k x n ), triple boucle sans aucun des noyaux testés
+template <typename MX, typename MY>
+Matrix referenceProduct(const MX& X, const MY& Y, int m, int n, int k)
+{
+  Matrix R(m, n, 0.);
+  for (int j = 0; j < n; ++j)
+    for (int l = 0; l < k; ++l)
+      for (int i = 0; i < m; ++i)
+	R(i, j) += X(i, l) * Y(l, j);
+  return R;
+}
+
+bool sameValues(const Matrix& X, const Matrix& R)
+{
+  if (X.nbRows != R.nbRows || X.nbCols != R.nbCols) return false;
+  for (int j = 0; j < R.nbCols; ++j)
+    for (int i = 0; i < R.nbRows; ++i)
+      if (X(i, j) != R(i, j)) return false;
+  return true;
+}
+
+// Affectations dont le membre de droite lit la cible, avec et sans changement de forme ( coefficients entiers :
+// les résultats sont exacts )
+bool verifAliasing()
+{
+  auto fill = [](Matrix& X, int shift) {
+    for (int j = 0; j < X.nbCols; ++j)
+      for (int i = 0; i < X.nbRows; ++i)
+	X(i, j) = double((i + 2 * j + shift) % 7 - 3);
+  };
+  bool ok = true;
+  {
+    Matrix C(3, 4), D(4, 5);
+    fill(C, 0); fill(D, 1);
+    Matrix R = referenceProduct(C, D, 3, 5, 4);
+    C = C * D;
+    ok = ok && sameValues(C, R);
+  }
+  {
+    Matrix C(4, 4), D(4, 4);
+    fill(C, 2); fill(D, 3);
+    Matrix R = referenceProduct(C, D, 4, 4, 4);
+    C = C * D;
+    ok = ok && sameValues(C, R);
+  }
+  {
+    Matrix C(3, 4), D(3, 2);
+    fill(C, 4); fill(D, 5);
+    Matrix R = referenceProduct(C.t(), D, 4, 2, 3);
+    C = 1. * C.t() * D;
+    ok = ok && sameValues(C, R);
+  }
+  if (!ok) std::cerr << "Erreur : affectation d'une expression qui lit sa cible" << std::endl;
+  return ok;
+}
+
+/*
+ * Usage : ./TestProductMatrix.exe [dim] [double|float|mixed]
+ *   double : matrices Matrix ( défaut )
+ *   float  : matrices FloatMatrix, calcul en float
+ *   mixed  : matrices FloatMatrix, calcul en double ( setMixedPrecision )
+ * Avec l'algorithme automatic, l'autotuner est réglé avant la mesure ( tuneProdMatMat ) et écrit son choix dans
+ * le fichier de réglage ( prodmatmat.tuning du répertoire courant, ou PROD_TUNING ).
+ */
 int main(int nargs, char *vargs[])
 {
   int dim = 1024;
   if (nargs > 1)
     dim = atoi(vargs[1]);
+  std::string precision = (nargs > 2 ? vargs[2] : "double");
+  if (precision != "double" && precision != "float" && precision != "mixed")
+    {
+      std::cerr << "Précision inconnue : " << precision << " ( double, float ou mixed )" << std::endl;
+      return EXIT_FAILURE;
+    }
   std::vector < double >uA, vA, uB, vB;
   std::tie(uA, vA, uB, vB) = computeTensors(dim);
 
-  Matrix A = initTensorMatrices(uA, vA);
-  Matrix B = initTensorMatrices(uB, vB);
-
   std::chrono::time_point < std::chrono::system_clock > start, end;
-  start = std::chrono::system_clock::now();
-  Matrix C = A * B;
-  end = std::chrono::system_clock::now();
+  bool isPassed = verifAliasing();
+  if (precision == "double")
+    {
+      Matrix A = initTensorMatrices<double>(uA, vA);
+      Matrix B = initTensorMatrices<double>(uB, vB);
+      tuneProdMatMat(A, B);
+      start = std::chrono::system_clock::now();
+      Matrix C = A * B;
+      end = std::chrono::system_clock::now();
+      isPassed = verifProduct(uA, vA, uB, vB, C) && isPassed;
+    }
+  else
+    {
+      // Accumulation en double : il ne reste que l'arrondi des entrées et de C ( quelques eps ). En float, les
+      // sommes ajoutent de l'ordre de sqrt(dim) eps.
+      const bool mixed = (precision == "mixed");
+      setMixedPrecision(mixed);
+      FloatMatrix A = initTensorMatrices<float>(uA, vA);
+      FloatMatrix B = initTensorMatrices<float>(uB, vB);
+      tuneProdMatMat(A, B);
+      start = std::chrono::system_clock::now();
+      FloatMatrix C = A * B;
+      end = std::chrono::system_clock::now();
+      isPassed = verifProduct(uA, vA, uB, vB, C, mixed ? 10. : 4. * std::sqrt(double(dim)) + 4.) && isPassed;
+    }
   std::chrono::duration < double >elapsed_seconds = end - start;
 
-  bool isPassed = verifProduct(uA, vA, uB, vB, C);
   if (isPassed)
     {
       std::cout << "Test passed\n";
-      std::cout << "Temps CPU produit matrice-matrice naif : " << elapsed_seconds.count() << " secondes\n";
+      std::cout << "Temps CPU produit matrice-matrice naif ( " << precision << " ) : " << elapsed_seconds.count()
+		<< " secondes\n";
       std::cout << "MFlops -> " << (2.*dim*dim*dim)/elapsed_seconds.count()/1000000 <<std::endl;
     }
   else
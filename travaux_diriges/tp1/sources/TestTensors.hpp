@@ -0,0 +1,57 @@
+#ifndef _TestTensors_hpp__
+# define _TestTensors_hpp__
+# include <cassert>
+# include <cmath>
+# include <iostream>
+# include <limits>
+# include <tuple>
+# include <vector>
+
+/*
+ * Jeu d'essai commun aux tests du produit matrice-matrice : matrices de rang 1 A = uA vA^T et B = uB vB^T, dont
+ * le produit est connu sans calcul matriciel, C = (vA.uB) uA vB^T. Chaque test remplit A et B dans sa propre
+ * structure ( Matrix, DistMatrix, MatrixFile ) et vérifie C coefficient par coefficient.
+ */
+
+/// Vecteurs uA, vA, uB, vB de dimension dim
+inline std::tuple<std::vector<double>,std::vector<double>,
+		  std::vector<double>,std::vector<double>>  computeTensors(int dim)
+{
+  double pi = std::acos(-1.0);
+  auto u1 = std::vector < double >(dim);
+  auto u2 = std::vector < double >(dim);
+  auto v1 = std::vector < double >(dim);
+  auto v2 = std::vector < double >(dim);
+
+  for (int i = 0; i < dim; i++)
+    {
+      u1[i] = std::cos(1.67 * i * pi / dim);
+      u2[i] = std::sin(2.03 * i * pi / dim + 0.25);
+      v1[i] = std::cos(1.23 * i * i * pi / (7.5 * dim));
+      v2[i] = std::sin(0.675 * i / (3.1 * dim));
+    }
+  return std::make_tuple(u1, u2, v1, v2);
+}
+
+inline double dot(const std::vector < double >&u, const std::vector < double >&v)
+{
+  assert(u.size() == v.size());
+  double scal = 0.0;
+  for (unsigned long i = 0UL; i < u.size(); ++i)
+    scal += u[i] * v[i];
+  return scal;
+}
+
+/// Compare C( irow, jcol ) = val à rightVal ( écart relatif au plus 100 eps ) ; message sur cerr sinon
+inline bool verifCoefficient(int irow, int jcol, double rightVal, double val)
+{
+  if (std::fabs(rightVal - val) > 100*std::fabs(val * std::numeric_limits < double >::epsilon()))
+    {
+      std::cerr << "Erreur numérique : valeur attendue pour C( " << irow << ", " << jcol
+		<< " ) -> " << rightVal << " mais valeur trouvée : " << val << std::endl;
+      return false;
+    }
+  return true;
+}
+
+#endif
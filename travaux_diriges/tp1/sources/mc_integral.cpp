@@ -0,0 +1,77 @@
+#include <mpi.h>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include "monte_carlo.hpp"
+
+/*
+ * Intégrales calculées par monte_carlo::integrate ; chaque intégrale n'est qu'une lambda.
+ *   pi      : 4 * indicatrice du quart de disque sur [0,1]^2 ( même calcul que pi_omp / pi_mpi ) ;
+ *   gauss5  : exp(-|x|^2) sur [0,1]^5, qui vaut ( sqrt(pi)/2 erf(1) )^5 ;
+ *   course2 : |sin(x^2)| exp(-x^2), l'intégrale de Exemples/Course2/integral_computation.py, sur [-6,6] au
+ *             lieu de [-100,100] ( exp(-36) : la queue est négligeable, et la variance bien plus faible ).
+ *
+ * Usage : mpirun -np P ./mc_integral.exe [nbSamples] [graine]
+ * Le nombre de threads par processus est donné par OMP_NUM_THREADS.
+ */
+
+template <int Dim, typename Integrand>
+void run(const char* name, const Integrand& f, const std::array<double, Dim>& lower,
+         const std::array<double, Dim>& upper, double exact, unsigned long long nbSamples, std::uint64_t seed,
+         int rank)
+{
+    monte_carlo::Result r = monte_carlo::integrate<Dim>(f, lower, upper, nbSamples, seed, MPI_COMM_WORLD);
+    if (rank != 0) return;
+    std::cout << std::left << std::setw(8) << name << std::right << " I ≈ " << std::setprecision(10) << std::setw(13)
+              << r.estimate << "  erreur type " << std::setprecision(3) << std::setw(9) << r.stdError;
+    if (!std::isnan(exact))
+        std::cout << "  ecart/erreur type " << std::setw(6) << std::fabs(r.estimate - exact) / r.stdError;
+    else
+        std::cout << "  " << std::setw(24) << " ";
+    std::cout << "  " << std::setw(8) << r.time << " s  " << std::setw(7) << r.samplesPerSecond / 1e6
+              << " Méch/s\n";
+}
+
+int main(int argc, char* argv[])
+{
+    MPI_Init(&argc, &argv);
+    int rank = 0, nbp = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nbp);
+
+    unsigned long long nbSamples = 100000000ULL;
+    unsigned long long seed = 2026ULL;
+    if (argc > 1) {
+        nbSamples = std::strtoull(argv[1], nullptr, 10);
+        if (nbSamples == 0ULL) nbSamples = 100000000ULL;
+    }
+    if (argc > 2) seed = std::strtoull(argv[2], nullptr, 10);
+
+    if (rank == 0) {
+        std::cout << nbSamples << " échantillons, graine " << seed << ", " << nbp << " processus";
+#if defined(_OPENMP)
+        std::cout << " x " << omp_get_max_threads() << " threads";
+#endif
+        std::cout << "\n";
+    }
+
+    const double pi = std::acos(-1.0);
+    run<2>("pi", [](monte_carlo::Point<2> x) { return (x[0] * x[0] + x[1] * x[1] <= 1.0) ? 4.0 : 0.0; },
+           {0.0, 0.0}, {1.0, 1.0}, pi, nbSamples, seed, rank);
+
+    run<5>("gauss5", [](monte_carlo::Point<5> x) {
+               double r2 = 0.0;
+               for (int d = 0; d < 5; ++d) r2 += x[d] * x[d];
+               return std::exp(-r2);
+           },
+           {0.0, 0.0, 0.0, 0.0, 0.0}, {1.0, 1.0, 1.0, 1.0, 1.0}, std::pow(0.5 * std::sqrt(pi) * std::erf(1.0), 5),
+           nbSamples, seed, rank);
+
+    run<1>("course2", [](monte_carlo::Point<1> x) { return std::fabs(std::sin(x[0] * x[0])) * std::exp(-x[0] * x[0]); },
+           {-6.0}, {6.0}, std::nan(""), nbSamples, seed, rank);
+
+    MPI_Finalize();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+#ifndef _monte_carlo_hpp__
+# define _monte_carlo_hpp__
+# include <mpi.h>
+# include <array>
+# include <cmath>
+# include <cstddef>
+# include <vector>
+# if defined(_OPENMP)
+#   include <omp.h>
+# endif
+# include "simd_rng.hpp"
+
+/*
+ * Intégration de Monte-Carlo hybride MPI + OpenMP d'une fonction f sur le pavé [lower, upper] de R^Dim :
+ *     I ≈ volume * moyenne des f(x_i), x_i uniformes dans le pavé.
+ *
+ * L'intégrande est un paramètre template ( foncteur ou lambda appelé avec un Point<Dim> x par valeur, de
+ * coordonnées x[d] ) : il est inliné dans la boucle de calcul, vectorisée, sans appel virtuel. Les échantillons
+ * suivent le découpage de simd_rng.hpp : blocs globaux de simd_rng::blockSamples, chacun tiré par son propre
+ * flux xoshiro256+ SIMD, répartis par blocs contigus entre les processus puis entre les threads
+ * ( schedule(static) ). Les points sont tirés par paquets de 1024, coordonnée par coordonnée.
+ *
+ * Moyenne et variance sont cumulées par paquet ( sommes décalées de la moyenne courante, cf. integrateBlock ),
+ * puis fusionnées par la formule de Chan, sans la perte de précision de sum(f^2) - N mean^2. Les fusions se
+ * font dans l'ordre des threads puis des rangs : le résultat est identique sur tous les rangs, et ne dépend de
+ * la répartition qu'aux arrondis près.
+ *
+ * Pour Dim = 2 et f l'indicatrice du quart de disque, les tirages sont exactement ceux de pi_omp.cpp.
+ */
+
+namespace monte_carlo
+{
+    /// Moments d'un ensemble de valeurs : effectif, moyenne, somme des carrés des écarts à la moyenne
+    struct Moments
+    {
+        double count = 0.0, mean = 0.0, m2 = 0.0;
+
+        void merge(const Moments& o)
+        {
+            if (o.count == 0.0) return;
+            const double n = count + o.count, delta = o.mean - mean;
+            mean += delta * o.count / n;
+            m2 += o.m2 + delta * delta * count * o.count / n;
+            count = n;
+        }
+    };
+
+    /**
+     * Point i d'un paquet, lu directement dans les tirages uniformes rangés par dimension : x[d] vaut
+     * lower[d] + width[d] * u[d * stride + i]. Dans la boucle vectorisée, x[d] est une lecture contiguë sur les
+     * voies, sans copie du point. L'intégrande le reçoit par valeur : une référence obligerait le compilateur à
+     * ranger en mémoire un Point par voie, et la boucle ne serait plus vectorisée.
+     */
+    template <int Dim>
+    struct Point
+    {
+        static constexpr std::size_t stride = 1024;  ///< points par paquet
+        const double* u;
+        const double* lower;
+        const double* width;
+        std::size_t i;
+
+        double operator[](int d) const { return lower[d] + width[d] * u[d * stride + i]; }
+        static constexpr int size() { return Dim; }
+    };
+
+    struct Result
+    {
+        double estimate;           ///< valeur approchée de l'intégrale
+        double variance;           ///< variance de l'estimateur ( volume^2 sigma^2 / N )
+        double stdError;           ///< sqrt(variance)
+        unsigned long long samples;
+        double time;               ///< temps de calcul, maximum sur les processus [s]
+        double samplesPerSecond;
+    };
+
+    /**
+     * Moments des valeurs de f sur le bloc global b des nbSamples échantillons. Somme et somme des carrés sont
+     * cumulées en un seul passage vectorisé ( omp simd ), décalées de la moyenne courante K :
+     * m2 = sum (f-K)^2 - (sum (f-K))^2 / n reste précis tant que K est proche de la moyenne ( f du premier
+     * point pour le premier paquet ).
+     */
+    template <int Dim, typename Integrand>
+    Moments integrateBlock(const Integrand& f, const std::array<double, Dim>& lower,
+                           const std::array<double, Dim>& width, std::uint64_t seed,
+                           unsigned long long nbSamples, unsigned long long b)
+    {
+        constexpr std::size_t tile = Point<Dim>::stride;
+        alignas(64) double u[Dim * tile];
+        simd_rng::Xoshiro256PlusSimd<> rng(simd_rng::streamSeed(seed, b));
+        Moments acc;
+        for (unsigned long long left = simd_rng::blockSize(nbSamples, b); left > 0ULL; ) {
+            const std::size_t n = left < tile ? std::size_t(left) : tile;
+            for (int d = 0; d < Dim; ++d) rng.fillUniform(u + d * tile, n);
+            const double shift = acc.count == 0.0 ? f(Point<Dim>{u, lower.data(), width.data(), 0}) : acc.mean;
+            double s1 = 0.0, s2 = 0.0;
+            #pragma omp simd reduction(+:s1, s2)
+            for (std::size_t i = 0; i < n; ++i) {
+                const double v = f(Point<Dim>{u, lower.data(), width.data(), i}) - shift;
+                s1 += v;
+                s2 += v * v;
+            }
+            Moments t;
+            t.count = double(n);
+            t.mean = shift + s1 / t.count;
+            t.m2 = s2 - s1 * s1 / t.count;
+            acc.merge(t);
+            left -= n;
+        }
+        return acc;
+    }
+
+    /// Intégrale de f sur [lower, upper] avec nbSamples points. Fonction collective sur comm.
+    template <int Dim, typename Integrand>
+    Result integrate(const Integrand& f, const std::array<double, Dim>& lower, const std::array<double, Dim>& upper,
+                     unsigned long long nbSamples, std::uint64_t seed, MPI_Comm comm)
+    {
+        int rank, nbp;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &nbp);
+        std::array<double, Dim> width;
+        double volume = 1.0;
+        for (int d = 0; d < Dim; ++d) {
+            width[d] = upper[d] - lower[d];
+            volume *= width[d];
+        }
+        const long long nbBlocks = (long long)simd_rng::nbBlocks(nbSamples);
+        const long long firstBlock = nbBlocks * rank / nbp, lastBlock = nbBlocks * (rank + 1) / nbp;
+
+        MPI_Barrier(comm);
+        const double t0 = MPI_Wtime();
+# if defined(_OPENMP)
+        std::vector<Moments> perThread(omp_get_max_threads());
+# else
+        std::vector<Moments> perThread(1);
+# endif
+        #pragma omp parallel
+        {
+# if defined(_OPENMP)
+            Moments& acc = perThread[omp_get_thread_num()];
+# else
+            Moments& acc = perThread[0];
+# endif
+            #pragma omp for schedule(static)
+            for (long long b = firstBlock; b < lastBlock; ++b)
+                acc.merge(integrateBlock<Dim>(f, lower, width, seed, nbSamples, (unsigned long long)b));
+        }
+        Moments local;
+        for (const Moments& m : perThread) local.merge(m);
+        double localTime = MPI_Wtime() - t0;
+
+        // Fusion des moments de tous les rangs, dans l'ordre des rangs, identique partout
+        std::vector<Moments> all(nbp);
+        MPI_Allgather(&local, 3, MPI_DOUBLE, all.data(), 3, MPI_DOUBLE, comm);
+        Moments global;
+        for (const Moments& m : all) global.merge(m);
+        double maxTime;
+        MPI_Allreduce(&localTime, &maxTime, 1, MPI_DOUBLE, MPI_MAX, comm);
+
+        Result r;
+        r.samples = nbSamples;
+        r.estimate = volume * global.mean;
+        r.variance = global.count > 1.0 ? volume * volume * global.m2 / (global.count - 1.0) / global.count : 0.0;
+        r.stdError = std::sqrt(r.variance);
+        r.time = maxTime;
+        r.samplesPerSecond = maxTime > 0.0 ? double(nbSamples) / maxTime : 0.0;
+        return r;
+    }
+}
+
+#endif
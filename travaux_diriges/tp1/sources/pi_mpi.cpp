@@ -1,40 +1,161 @@
 #include <mpi.h>
-#include <chrono>
-#include <random>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
 #include <cstdlib>
-#include <sstream>
-#include <string>
-#include <fstream>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <vector>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#include "simd_rng.hpp"
+#include "sobol.hpp"
 
 struct LocalResult {
     unsigned long long samples = 0ULL;
     unsigned long long dartsInCircle = 0ULL;
 };
 
-// Simulation de Monte-Carlo pour approximer Pi
-static LocalResult approximate_pi_counts(unsigned long long samples, unsigned long long seed)
+// Bilan d'un rang, réduit en une seule opération : sommes des comptes, maximum des temps
+struct RankSummary {
+    unsigned long long samples;
+    unsigned long long dartsInCircle;
+    double time;
+};
+
+static void combineSummaries(void* in, void* inout, int* len, MPI_Datatype*)
 {
-    std::mt19937_64 gen(seed);
-    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    const RankSummary* a = static_cast<const RankSummary*>(in);
+    RankSummary* b = static_cast<RankSummary*>(inout);
+    for (int i = 0; i < *len; ++i) {
+        b[i].samples += a[i].samples;
+        b[i].dartsInCircle += a[i].dartsInCircle;
+        b[i].time = std::max(b[i].time, a[i].time);
+    }
+}
+
+static MPI_Datatype createSummaryType()
+{
+    int lengths[3] = {1, 1, 1};
+    MPI_Aint offsets[3] = {offsetof(RankSummary, samples), offsetof(RankSummary, dartsInCircle),
+                           offsetof(RankSummary, time)};
+    MPI_Datatype types[3] = {MPI_UNSIGNED_LONG_LONG, MPI_UNSIGNED_LONG_LONG, MPI_DOUBLE};
+    MPI_Datatype tmp, type;
+    MPI_Type_create_struct(3, lengths, offsets, types, &tmp);
+    MPI_Type_create_resized(tmp, 0, sizeof(RankSummary), &type);
+    MPI_Type_free(&tmp);
+    MPI_Type_commit(&type);
+    return type;
+}
 
+// Simulation de Monte-Carlo pour approximer Pi : points tirés dans [0,1)^2 par xoshiro256+ sur 8 voies SIMD,
+// comptage sans branchement des points du quart de disque. Le rang traite les blocs globaux [firstBlock,
+// lastBlock) des totalSamples échantillons, chaque bloc ayant son propre flux ( cf. simd_rng.hpp ) : le total
+// ne dépend que de (seed, totalSamples), pas du nombre de processus ni de threads.
+static LocalResult approximate_pi_counts(unsigned long long totalSamples, unsigned long long firstBlock,
+                                         unsigned long long lastBlock, unsigned long long seed)
+{
+    unsigned long long samples = 0ULL, hits = 0ULL;
+    #pragma omp parallel for schedule(static) reduction(+:samples, hits)
+    for (long long b = (long long)firstBlock; b < (long long)lastBlock; ++b) {
+        samples += simd_rng::blockSize(totalSamples, (unsigned long long)b);
+        hits += simd_rng::countHitsBlock(seed, totalSamples, (unsigned long long)b);
+    }
     LocalResult r;
     r.samples = samples;
+    r.dartsInCircle = hits;
+    return r;
+}
+
+// Demi-largeur de l'intervalle de confiance à 95 % sur pi = 4 p, p = hits / samples ( loi binomiale )
+static double halfWidth95(unsigned long long samples, unsigned long long hits)
+{
+    double p = (double)hits / (double)samples;
+    return 4.0 * 1.96 * std::sqrt(p * (1.0 - p) / (double)samples);
+}
 
-    for (unsigned long long s = 0ULL; s < samples; ++s) {
-        double x = dist(gen);
-        double y = dist(gen);
-        if (x*x + y*y <= 1.0) r.dartsInCircle++;
+// Mode précision cible : les rangs tirent des paquets de chunkBlocks blocs, le tour r occupant les blocs
+// globaux [r * nbp * chunkBlocks, (r + 1) * nbp * chunkBlocks). Après chaque paquet, la somme des comptes
+// cumulés est lancée par MPI_Iallreduce et s'exécute pendant le paquet suivant ; à la fin de celui-ci, tous
+// les rangs testent la même somme et s'arrêtent ensemble dès que la demi-largeur de l'intervalle de confiance
+// passe sous tol. Le dépassement est donc d'au plus deux tours. maxSamples borne le nombre total de tirages.
+static LocalResult approximate_pi_tolerance(double tol, unsigned long long maxSamples, unsigned long long chunkBlocks,
+                                            unsigned long long seed, int rank, int nbp, MPI_Comm comm, int& rounds)
+{
+    const unsigned long long nbBlocks = simd_rng::nbBlocks(maxSamples);
+    const unsigned long long roundBlocks = chunkBlocks * (unsigned long long)nbp;
+    unsigned long long sent[2], sums[2];
+    MPI_Request request = MPI_REQUEST_NULL;
+    LocalResult local;
+    rounds = 0;
+    for (unsigned long long first = 0ULL; first < nbBlocks; first += roundBlocks) {
+        unsigned long long b0 = std::min(nbBlocks, first + (unsigned long long)rank * chunkBlocks);
+        unsigned long long b1 = std::min(nbBlocks, b0 + chunkBlocks);
+        LocalResult chunk = approximate_pi_counts(maxSamples, b0, b1, seed);
+        local.samples += chunk.samples;
+        local.dartsInCircle += chunk.dartsInCircle;
+        ++rounds;
+
+        if (request != MPI_REQUEST_NULL) {
+            MPI_Wait(&request, MPI_STATUS_IGNORE);
+            if (halfWidth95(sums[0], sums[1]) <= tol) break;
+        }
+        // sent ne doit pas être modifié avant la fin de la réduction
+        sent[0] = local.samples;
+        sent[1] = local.dartsInCircle;
+        MPI_Iallreduce(sent, sums, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm, &request);
+    }
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    return local;
+}
+
+// Mode quasi-Monte-Carlo : le rang traite les indices [first, last) de la suite de Sobol pour chacun des
+// brouillages r = 0..nbScrambles-1 ( graine streamSeed(seed, r) ). hits[r] reçoit le compte du brouillage r ;
+// le résultat rendu cumule tous les brouillages.
+static LocalResult approximate_pi_qmc(unsigned long long first, unsigned long long last, unsigned long long seed,
+                                      std::vector<unsigned long long>& hits)
+{
+    const unsigned long long chunk = simd_rng::blockSamples;
+    const long long nbChunks = (long long)((last - first + chunk - 1ULL) / chunk);
+    LocalResult r;
+    for (std::size_t s = 0; s < hits.size(); ++s) {
+        const qmc::ScrambledSobol2D sobol(simd_rng::streamSeed(seed, s));
+        unsigned long long h = 0ULL;
+        // Les threads se partagent la plage par paquets d'indices
+        #pragma omp parallel for schedule(static) reduction(+:h)
+        for (long long c = 0; c < nbChunks; ++c) {
+            const unsigned long long i0 = first + (unsigned long long)c * chunk;
+            h += sobol.countInQuarterDisk(i0, std::min(last, i0 + chunk));
+        }
+        hits[s] = h;
+        r.samples += last - first;
+        r.dartsInCircle += hits[s];
     }
     return r;
 }
 
+// Erreur type de la moyenne des estimations 4 hits[r] / samples des R brouillages
+static double rqmcStandardError(const std::vector<unsigned long long>& hits, unsigned long long samples)
+{
+    const double R = (double)hits.size();
+    double mean = 0.0, var = 0.0;
+    for (unsigned long long h : hits) mean += 4.0 * (double)h / (double)samples;
+    mean /= R;
+    for (unsigned long long h : hits) {
+        double d = 4.0 * (double)h / (double)samples - mean;
+        var += d * d;
+    }
+    return std::sqrt(var / (R - 1.0) / R);
+}
+
 int main(int argc, char* argv[])
 {
-    // Initialisation de l'environnement MPI
-    MPI_Init(&argc, &argv);
+    // Initialisation de l'environnement MPI : seul le thread principal fait des appels MPI
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
 
     MPI_Comm globComm;
     MPI_Comm_dup(MPI_COMM_WORLD, &globComm);
@@ -43,57 +164,105 @@ int main(int argc, char* argv[])
     MPI_Comm_size(globComm, &nbp);
     MPI_Comm_rank(globComm, &rank);
 
-    // Valeur par défaut : 100 millions d'échantillons
-    unsigned long long totalSamples = 100000000ULL; 
-    if (argc > 1) {
-        totalSamples = std::strtoull(argv[1], nullptr, 10);
-        if (totalSamples == 0ULL) totalSamples = 100000000ULL;
+    // Usage : mpirun -np P ./pi_mpi.exe [totalSamples] [graine] [-tol eps] [-chunk blocs] [-qmc R]
+    // Chaque processus utilise OMP_NUM_THREADS threads.
+    // Valeur par défaut : 100 millions d'échantillons, graine fixe ( résultats reproductibles ).
+    // Avec -tol, le calcul s'arrête dès que l'intervalle de confiance à 95 % sur pi a une demi-largeur
+    // inférieure à eps ; totalSamples n'est plus qu'un maximum ( 1e12 par défaut ). -chunk donne le nombre de
+    // blocs de simd_rng::blockSamples tirés par chaque rang entre deux tests ( 16 par défaut ).
+    // Avec -qmc R, les totalSamples premiers points de Sobol ( de préférence une puissance de 2 ) sont utilisés
+    // avec R brouillages indépendants ( R >= 2 ) : pi est leur moyenne, l'erreur type vient de leur dispersion.
+    // -tol est alors ignoré.
+    unsigned long long totalSamples = 0ULL;
+    unsigned long long seed = 2026ULL;
+    unsigned long long chunkBlocks = 16ULL;
+    double tol = 0.0;
+    int nbScrambles = 0;
+    int pos = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-tol") == 0 && i + 1 < argc)
+            tol = std::strtod(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "-chunk") == 0 && i + 1 < argc)
+            chunkBlocks = std::max(1ULL, std::strtoull(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "-qmc") == 0 && i + 1 < argc)
+            nbScrambles = std::max(2, std::atoi(argv[++i]));
+        else if (pos++ == 0)
+            totalSamples = std::strtoull(argv[i], nullptr, 10);
+        else
+            seed = std::strtoull(argv[i], nullptr, 10);
     }
+    if (nbScrambles > 0) tol = 0.0;
+    if (totalSamples == 0ULL) totalSamples = (tol > 0.0 ? 1000000000000ULL : 100000000ULL);
 
-    // Répartition équitable de la charge de calcul
-    unsigned long long base = totalSamples / (unsigned long long)nbp;
-    unsigned long long rem  = totalSamples % (unsigned long long)nbp;
-    unsigned long long localSamples = base + ((unsigned long long)rank < rem ? 1ULL : 0ULL);
+    // Répartition équitable des blocs d'échantillons
+    unsigned long long nbBlocks = simd_rng::nbBlocks(totalSamples);
+    unsigned long long base = nbBlocks / (unsigned long long)nbp;
+    unsigned long long rem  = nbBlocks % (unsigned long long)nbp;
+    unsigned long long firstBlock = (unsigned long long)rank * base + std::min((unsigned long long)rank, rem);
+    unsigned long long lastBlock  = firstBlock + base + ((unsigned long long)rank < rem ? 1ULL : 0ULL);
 
-    // Initialisation de la graine aléatoire unique par rang
-    using clock_t = std::chrono::high_resolution_clock;
-    unsigned long long t = (unsigned long long)clock_t::now().time_since_epoch().count();
-    unsigned long long seed = t ^ (0x9e3779b97f4a7c15ULL * (unsigned long long)(rank + 1));
+    // Répartition des indices de la suite de Sobol
+    base = totalSamples / (unsigned long long)nbp;
+    rem  = totalSamples % (unsigned long long)nbp;
+    unsigned long long firstIndex = (unsigned long long)rank * base + std::min((unsigned long long)rank, rem);
+    unsigned long long lastIndex  = firstIndex + base + ((unsigned long long)rank < rem ? 1ULL : 0ULL);
+    std::vector<unsigned long long> scrambleHits(nbScrambles), globalScrambleHits(nbScrambles);
 
     // Synchronisation avant de démarrer le chronomètre
     MPI_Barrier(globComm);
     double t0 = MPI_Wtime();
 
-    LocalResult local = approximate_pi_counts(localSamples, seed);
+    int rounds = 1;
+    LocalResult local;
+    if (nbScrambles > 0)
+        local = approximate_pi_qmc(firstIndex, lastIndex, seed, scrambleHits);
+    else if (tol > 0.0)
+        local = approximate_pi_tolerance(tol, totalSamples, chunkBlocks, seed, rank, nbp, globComm, rounds);
+    else
+        local = approximate_pi_counts(totalSamples, firstBlock, lastBlock, seed);
 
     MPI_Barrier(globComm);
     double t1 = MPI_Wtime();
     double localTime = t1 - t0;
 
-    // Réduction des résultats locaux vers le processus 0
-    unsigned long long globalSamples = 0ULL;
-    unsigned long long globalDarts   = 0ULL;
-
-    MPI_Reduce(&local.samples, &globalSamples, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, globComm);
-    MPI_Reduce(&local.dartsInCircle, &globalDarts, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, globComm);
-
-    double maxTime = 0.0;
-    MPI_Reduce(&localTime, &maxTime, 1, MPI_DOUBLE, MPI_MAX, 0, globComm);
-
-    // Calcul local de Pi pour le fichier de sortie
-    double localPi = 4.0 * (double)local.dartsInCircle / (double)local.samples;
+    // Réduction des bilans vers le processus 0 : une seule opération sur un type dérivé
+    MPI_Datatype summaryType = createSummaryType();
+    MPI_Op summaryOp;
+    MPI_Op_create(&combineSummaries, 1, &summaryOp);
+    RankSummary localSummary = {local.samples, local.dartsInCircle, localTime}, globalSummary;
+    MPI_Reduce(&localSummary, &globalSummary, 1, summaryType, summaryOp, 0, globComm);
+    MPI_Op_free(&summaryOp);
+    MPI_Type_free(&summaryType);
+    const unsigned long long globalSamples = globalSummary.samples;
+    const unsigned long long globalDarts   = globalSummary.dartsInCircle;
+    const double maxTime = globalSummary.time;
+    if (nbScrambles > 0)
+        MPI_Reduce(scrambleHits.data(), globalScrambleHits.data(), nbScrambles, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+                   0, globComm);
 
-    // Sauvegarde des résultats individuels dans des fichiers
-    std::stringstream fileName;
-    fileName << "Output" << std::setfill('0') << std::setw(5) << rank << ".txt";
-    std::ofstream output(fileName.str().c_str());
+    // Calcul local de Pi pour le fichier de sortie ( un rang peut n'avoir aucun bloc )
+    double localPi = local.samples ? 4.0 * (double)local.dartsInCircle / (double)local.samples : 0.0;
 
-    output << "Rang=" << rank << " nbp=" << nbp << "\n";
-    output << "Echantillons_locaux=" << local.samples << "\n";
-    output << "Points_dans_le_cercle=" << local.dartsInCircle << "\n";
-    output << "Pi_local=" << std::setprecision(17) << localPi << "\n";
-    output << "Temps_local(s)=" << std::setprecision(6) << localTime << "\n";
-    output.close();
+    // Résultats individuels : une ligne de longueur fixe par rang dans un seul fichier, écrite à la position
+    // rank * lineLength par une écriture collective ( MPI-IO regroupe les écritures )
+    int nbThreads = 1;
+#if defined(_OPENMP)
+    nbThreads = omp_get_max_threads();
+#endif
+    constexpr int lineLength = 160;
+    char line[lineLength + 1];
+    int n = std::snprintf(line, sizeof(line),
+                          "Rang=%d nbp=%d Threads=%d Echantillons_locaux=%llu Points_dans_le_cercle=%llu "
+                          "Pi_local=%.17g Temps_local(s)=%.6g",
+                          rank, nbp, nbThreads, local.samples, local.dartsInCircle, localPi, localTime);
+    n = std::min(n, lineLength - 1);
+    std::memset(line + n, ' ', lineLength - 1 - n);
+    line[lineLength - 1] = '\n';
+    MPI_File output;
+    MPI_File_open(globComm, "Output_rangs.txt", MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &output);
+    MPI_File_set_size(output, (MPI_Offset)nbp * lineLength);
+    MPI_File_write_at_all(output, (MPI_Offset)rank * lineLength, line, lineLength, MPI_CHAR, MPI_STATUS_IGNORE);
+    MPI_File_close(&output);
 
     // Affichage des résultats globaux par le processus 0
     if (rank == 0) {
@@ -103,6 +272,17 @@ int main(int argc, char* argv[])
         
         std::cout << "Pi global \u2248 " << std::setprecision(17) << pi << "\n";
         std::cout << "Nombre total d'echantillons : " << globalSamples << "\n";
+        std::cout << "Graine : " << seed << "\n";
+        if (nbScrambles > 0) {
+            std::cout << "Quasi-Monte-Carlo : " << totalSamples << " points de Sobol x " << nbScrambles
+                      << " brouillages\n";
+            std::cout << "Erreur type RQMC : " << std::setprecision(3)
+                      << rqmcStandardError(globalScrambleHits, totalSamples) << "\n";
+        } else {
+            std::cout << "Demi-largeur IC 95 % : " << std::setprecision(3) << halfWidth95(globalSamples, globalDarts);
+            if (tol > 0.0) std::cout << " ( tolerance " << tol << ", " << rounds << " tours )";
+            std::cout << "\n";
+        }
         std::cout << "Temps d'execution (max entre rangs) [s] : " << std::setprecision(6) << maxTime << "\n";
         std::cout << "Performance estimee [Mop/s] : " << std::setprecision(3) << mflops << "\n";
     }
@@ -1,58 +1,40 @@
 #include <chrono>
-#include <random>
 #include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include "simd_rng.hpp"
 
 #if defined(_OPENMP)
   #include <omp.h>
 #endif
 
-double approximate_pi_omp(unsigned long long nbSamples)
+// Los bloques de muestras (simd_rng::blockSamples) tienen numeración global y cada uno su propio generador:
+// el resultado depende solo de (seed, nbSamples), no del número de hilos ni del reparto entre ellos
+double approximate_pi_omp(unsigned long long nbSamples, unsigned long long seed)
 {
-    using clock_t = std::chrono::high_resolution_clock;
     unsigned long long inside = 0ULL;
+    const long long nbBlocks = (long long)simd_rng::nbBlocks(nbSamples);
 
-    // Semilla base a partir del tiempo
-    unsigned long long baseSeed =
-        (unsigned long long)clock_t::now().time_since_epoch().count();
-
-    #pragma omp parallel reduction(+:inside)
-    {
-        // Un generador por hilo (thread-safe)
-        unsigned long long seed = baseSeed;
-
-        #if defined(_OPENMP)
-          int tid = omp_get_thread_num();
-          seed ^= 0x9e3779b97f4a7c15ULL * (unsigned long long)(tid + 1);
-        #else
-          seed ^= 0x9e3779b97f4a7c15ULL;
-        #endif
-
-        std::mt19937_64 gen(seed);
-        std::uniform_real_distribution<double> dist(-1.0, 1.0);
-
-        #pragma omp for schedule(static)
-        for (unsigned long long s = 0ULL; s < nbSamples; ++s) {
-            double x = dist(gen);
-            double y = dist(gen);
-            if (x*x + y*y <= 1.0) inside += 1ULL;
-        }
-    }
+    #pragma omp parallel for schedule(static) reduction(+:inside)
+    for (long long b = 0; b < nbBlocks; ++b)
+        inside += simd_rng::countHitsBlock(seed, nbSamples, (unsigned long long)b);
 
     return 4.0 * (double)inside / (double)nbSamples;
 }
 
 int main(int argc, char* argv[])
 {
+    // Uso: ./pi_omp.exe [nbSamples] [seed]
     unsigned long long nbSamples = 10000000ULL; // 1e7 por defecto
+    unsigned long long seed = 2026ULL;          // semilla fija: resultados reproducibles
     if (argc > 1) {
         nbSamples = std::strtoull(argv[1], nullptr, 10);
         if (nbSamples == 0ULL) nbSamples = 10000000ULL;
     }
+    if (argc > 2) seed = std::strtoull(argv[2], nullptr, 10);
 
     auto t0 = std::chrono::high_resolution_clock::now();
-    double pi = approximate_pi_omp(nbSamples);
+    double pi = approximate_pi_omp(nbSamples, seed);
     auto t1 = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> dt = t1 - t0;
 
@@ -64,6 +46,7 @@ int main(int argc, char* argv[])
 
     std::cout << "OpenMP threads: " << threads << "\n";
     std::cout << "Samples: " << nbSamples << "\n";
+    std::cout << "Seed: " << seed << "\n";
     std::cout << "Pi ≈ " << std::setprecision(17) << pi << "\n";
     std::cout << "Tiempo (s): " << dt.count() << "\n";
     std::cout << "Muestras/s: " << (double)nbSamples / dt.count() << "\n";
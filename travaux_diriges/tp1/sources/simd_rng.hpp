@@ -0,0 +1,151 @@
+#ifndef _simd_rng_hpp__
+# define _simd_rng_hpp__
+# include <cstddef>
+# include <cstdint>
+# include <cstring>
+
+/*
+ * Générateur xoshiro256+ ( Blackman & Vigna ) en Lanes flux indépendants calculés côte à côte : l'état est
+ * rangé par mot ( s[mot][voie] ), de sorte que chaque étape du générateur est une boucle sur les voies que le
+ * compilateur vectorise ( 4 voies par registre AVX2, 8 voies = 2 registres ). Les tirages sont convertis en
+ * doubles sans division : les 52 bits de poids fort forment la mantisse d'un double de [1,2), auquel on
+ * retire 1.
+ *
+ * Pas de sortie des bits de poids faible ( les plus faibles de xoshiro256+ ) : ils tombent dans le décalage.
+ *
+ * Reproductibilité : les échantillons d'un calcul sont numérotés globalement et découpés en blocs de
+ * blockSamples. Le bloc b est tiré par son propre générateur, de graine streamSeed(seed, b), et ne dépend donc
+ * ni de qui le calcule ni de l'ordre de calcul ; les comptes sont des entiers, leur somme est exacte. Un
+ * couple (seed, nbSamples) donne ainsi le même résultat pour tout nombre de threads ou de processus.
+ */
+
+namespace simd_rng
+{
+    /// splitmix64 : sert à remplir l'état à partir d'une seule graine
+    inline std::uint64_t splitmix64(std::uint64_t& x)
+    {
+        std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /// Graine du flux numéro stream : deux passes de splitmix64 séparent des flux voisins
+    inline std::uint64_t streamSeed(std::uint64_t seed, std::uint64_t stream)
+    {
+        std::uint64_t x = stream;
+        x = seed ^ splitmix64(x);
+        return splitmix64(x);
+    }
+
+    /// Double de [0,1) formé des 52 bits de poids fort de x
+    inline double toUnitDouble(std::uint64_t x)
+    {
+        std::uint64_t bits = (x >> 12) | 0x3FF0000000000000ULL;
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        return d - 1.0;
+    }
+
+    template <int Lanes = 8>
+    class Xoshiro256PlusSimd
+    {
+    public:
+        static constexpr int lanes = Lanes;
+
+        explicit Xoshiro256PlusSimd(std::uint64_t seed) { reseed(seed); }
+
+        void reseed(std::uint64_t seed)
+        {
+            std::uint64_t x = seed;
+            for (int l = 0; l < Lanes; ++l)
+                for (int w = 0; w < 4; ++w) m_s[w][l] = splitmix64(x);
+        }
+
+        /// Remplit out[0:n) de doubles uniformes dans [0,1) ; n est arrondi au multiple de Lanes supérieur
+        void fillUniform(double* out, std::size_t n)
+        {
+            std::uint64_t s0[Lanes], s1[Lanes], s2[Lanes], s3[Lanes];
+            std::memcpy(s0, m_s[0], sizeof(s0));
+            std::memcpy(s1, m_s[1], sizeof(s1));
+            std::memcpy(s2, m_s[2], sizeof(s2));
+            std::memcpy(s3, m_s[3], sizeof(s3));
+            for (std::size_t i = 0; i < n; i += Lanes) {
+                #pragma omp simd
+                for (int l = 0; l < Lanes; ++l) {
+                    const std::uint64_t result = s0[l] + s3[l];
+                    const std::uint64_t t = s1[l] << 17;
+                    s2[l] ^= s0[l];
+                    s3[l] ^= s1[l];
+                    s1[l] ^= s2[l];
+                    s0[l] ^= s3[l];
+                    s2[l] ^= t;
+                    s3[l] = (s3[l] << 45) | (s3[l] >> 19);
+                    out[i + l] = toUnitDouble(result);
+                }
+            }
+            std::memcpy(m_s[0], s0, sizeof(s0));
+            std::memcpy(m_s[1], s1, sizeof(s1));
+            std::memcpy(m_s[2], s2, sizeof(s2));
+            std::memcpy(m_s[3], s3, sizeof(s3));
+        }
+
+    private:
+        alignas(64) std::uint64_t m_s[4][Lanes];
+    };
+
+    /// Nombre de points (x[i], y[i]) dans le quart de disque unité, sans branchement ( boucle vectorisée )
+    inline unsigned long long countInQuarterDisk(const double* x, const double* y, std::size_t n)
+    {
+        unsigned long long hits = 0ULL;
+        #pragma omp simd reduction(+:hits)
+        for (std::size_t i = 0; i < n; ++i)
+            hits += (x[i] * x[i] + y[i] * y[i] <= 1.0);
+        return hits;
+    }
+
+    /**
+     * Tire samples points uniformes dans [0,1)^2 par blocs de block points et compte ceux du quart de disque :
+     * pi ≈ 4 * hits / samples. Les blocs tiennent dans le cache L1.
+     */
+    template <typename Rng>
+    unsigned long long countHits(Rng& rng, unsigned long long samples)
+    {
+        constexpr std::size_t block = 1024;
+        static_assert(block % Rng::lanes == 0, "bloc multiple du nombre de voies");
+        alignas(64) double x[block], y[block];
+        unsigned long long hits = 0ULL;
+        while (samples > 0ULL) {
+            const std::size_t n = samples < block ? std::size_t(samples) : block;
+            rng.fillUniform(x, n);
+            rng.fillUniform(y, n);
+            hits += countInQuarterDisk(x, y, n);
+            samples -= n;
+        }
+        return hits;
+    }
+
+    /// Taille des blocs de l'espace global des échantillons
+    constexpr unsigned long long blockSamples = 1ULL << 16;
+
+    inline unsigned long long nbBlocks(unsigned long long nbSamples)
+    {
+        return (nbSamples + blockSamples - 1ULL) / blockSamples;
+    }
+
+    /// Nombre d'échantillons du bloc b ( le dernier peut être incomplet )
+    inline unsigned long long blockSize(unsigned long long nbSamples, unsigned long long b)
+    {
+        const unsigned long long first = b * blockSamples;
+        return (nbSamples - first < blockSamples ? nbSamples - first : blockSamples);
+    }
+
+    /// Points du quart de disque pour le bloc b des nbSamples échantillons du calcul de graine seed
+    inline unsigned long long countHitsBlock(std::uint64_t seed, unsigned long long nbSamples, unsigned long long b)
+    {
+        Xoshiro256PlusSimd<> rng(streamSeed(seed, b));
+        return countHits(rng, blockSize(nbSamples, b));
+    }
+}
+
+#endif
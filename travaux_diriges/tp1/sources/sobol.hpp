@@ -0,0 +1,84 @@
+#ifndef _sobol_hpp__
+# define _sobol_hpp__
+# include <cstdint>
+# include "simd_rng.hpp"
+
+/*
+ * Suite de Sobol en dimension 2, brouillée, pour l'intégration quasi-Monte-Carlo ( erreur en O(log N / N)
+ * environ pour une fonction régulière, contre O(N^-1/2) pour des tirages pseudo-aléatoires ).
+ *
+ * Les nombres directeurs sont sur 64 bits ( le bit 63 est le premier chiffre binaire après la virgule ) :
+ *   dimension 0 : v_k = 2^-(k+1) ( suite de van der Corput ) ;
+ *   dimension 1 : polynôme primitif x + 1, soit v_k = v_{k-1} xor ( v_{k-1} >> 1 ).
+ * Le point d'indice i est le xor des v_k pour les bits k de gray(i) = i xor (i >> 1) : on passe d'un indice au
+ * suivant par un seul xor ( bit de poids faible qui change ), et on peut démarrer à n'importe quel indice. Des
+ * threads ou processus peuvent donc se partager des plages d'indices disjointes. Pour N puissance de 2, les
+ * points d'indices [0, N) sont exactement les N premiers points de Sobol, dans un autre ordre.
+ *
+ * Brouillage ( Matoušek ) : chaque coordonnée est multipliée ( dans GF(2) ) par une matrice triangulaire
+ * inférieure aléatoire à diagonale unité, puis un décalage digital aléatoire lui est appliqué par xor. Le
+ * brouillage étant linéaire, il est appliqué une fois pour toutes aux nombres directeurs. Chaque point brouillé
+ * reste uniforme sur [0,1)^2 : la moyenne de R estimations de graines différentes est sans biais, et leur
+ * dispersion donne l'erreur ( quasi-Monte-Carlo randomisé ).
+ */
+
+namespace qmc
+{
+    class ScrambledSobol2D
+    {
+    public:
+        static constexpr int bits = 64;
+
+        explicit ScrambledSobol2D(std::uint64_t seed)
+        {
+            std::uint64_t v[2][bits];
+            v[0][0] = v[1][0] = 1ULL << 63;
+            for (int k = 1; k < bits; ++k) {
+                v[0][k] = v[0][k - 1] >> 1;
+                v[1][k] = v[1][k - 1] ^ (v[1][k - 1] >> 1);
+            }
+            std::uint64_t x = seed;
+            for (int d = 0; d < 2; ++d) {
+                // Ligne du chiffre de position pos : lui-même et des chiffres plus significatifs tirés au hasard
+                std::uint64_t rows[bits];
+                for (int pos = 0; pos < bits; ++pos)
+                    rows[pos] = (1ULL << pos) | (simd_rng::splitmix64(x) & ~((2ULL << pos) - 1ULL));
+                for (int k = 0; k < bits; ++k) {
+                    std::uint64_t w = 0ULL;
+                    for (int pos = 0; pos < bits; ++pos)
+                        w |= std::uint64_t(__builtin_parityll(rows[pos] & v[d][k])) << pos;
+                    m_v[d][k] = w;
+                }
+                m_shift[d] = simd_rng::splitmix64(x);
+            }
+        }
+
+        /// Nombre de points d'indices [first, last) dans le quart de disque unité
+        unsigned long long countInQuarterDisk(std::uint64_t first, std::uint64_t last) const
+        {
+            if (first >= last) return 0ULL;
+            std::uint64_t x = m_shift[0], y = m_shift[1];
+            for (std::uint64_t g = first ^ (first >> 1); g != 0ULL; g &= g - 1ULL) {
+                const int k = __builtin_ctzll(g);
+                x ^= m_v[0][k];
+                y ^= m_v[1][k];
+            }
+            unsigned long long hits = 0ULL;
+            for (std::uint64_t i = first; ; ) {
+                const double u = simd_rng::toUnitDouble(x), w = simd_rng::toUnitDouble(y);
+                hits += (u * u + w * w <= 1.0);
+                if (++i == last) break;
+                const int k = __builtin_ctzll(i);
+                x ^= m_v[0][k];
+                y ^= m_v[1][k];
+            }
+            return hits;
+        }
+
+    private:
+        std::uint64_t m_v[2][bits];
+        std::uint64_t m_shift[2];
+    };
+}
+
+#endif
@@ -82,7 +82,7 @@ int main(int nargs, char *vargs[])
   std::chrono::time_point < std::chrono::system_clock > start, end;
   start = std::chrono::system_clock::now();
   Matrix C(dim,dim);
-  dgemm_('N', 'N', dim, dim, dim, 1., A.data(), dim, B.data(), dim, 0., C.data(), dim);
+  dgemm_('N', 'N', dim, dim, dim, 1., A.data(), A.ld(), B.data(), B.ld(), 0., C.data(), C.ld());
   end = std::chrono::system_clock::now();
   std::chrono::duration < double >elapsed_seconds = end - start;
 